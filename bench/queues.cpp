@@ -0,0 +1,107 @@
+/**
+ * A micro-benchmark of the queues between the game and its AI
+ *
+ * A producer thread pushes values a consumer thread pops, through the
+ * mutex-based PollingQueue then through the lock-free SpscQueue.
+ *
+ * The SpscQueue is measured with the capacity of the queues of GameAI, where
+ * the producer often finds the queue full and waits, and with a large one.
+ */
+#include "pollingqueue.h"
+#include "spscqueue.h"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <cassert>
+#include <cstdint>
+
+namespace {
+constexpr std::size_t valueCount = 1'000'000;
+
+/**
+ * A value about as big as the boards sent to the AI
+ */
+struct Payload {
+    std::array<std::uint64_t, 32> words{};
+};
+
+template<typename Queue, typename PushFunc, typename PopFunc>
+double measure(Queue& queue, PushFunc push, PopFunc pop)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer{[&queue, &push] {
+        for (std::size_t i = 0; i < valueCount; ++i) {
+            Payload payload{};
+            payload.words[0] = i;
+            push(queue, std::move(payload));
+        }
+    }};
+
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < valueCount; ++i) {
+        sum += pop(queue).words[0];
+    }
+    producer.join();
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    assert(sum == valueCount * (valueCount - 1) / 2);
+    (void)sum;
+
+    return elapsed.count() / valueCount;
+}
+
+template<std::size_t Capacity>
+void measureSpscQueue()
+{
+    SpscQueue<Payload, Capacity> spscQueue{};
+    double spscTime = measure(
+        spscQueue,
+        [](auto& queue, Payload&& payload) {
+            queue.push(std::move(payload));
+        },
+        [](auto& queue) {
+            return *queue.waitPop();
+        });
+    std::cout << "SpscQueue<" << Capacity << ">: " << spscTime << " ns per value\n";
+
+    SpscQueue<Payload, Capacity> tryQueue{};
+    double tryTime = measure(
+        tryQueue,
+        [](auto& queue, Payload&& payload) {
+            queue.push(std::move(payload));
+        },
+        [](auto& queue) {
+            auto value = queue.tryPop();
+            while (!value) {
+                std::this_thread::yield();
+                value = queue.tryPop();
+            }
+            return *value;
+        });
+    std::cout << "SpscQueue<" << Capacity << ">, polled: " << tryTime << " ns per value\n";
+}
+} // namespace
+
+int main()
+{
+    PollingQueue<Payload> pollingQueue{};
+    double pollingTime = measure(
+        pollingQueue,
+        [](auto& queue, Payload&& payload) {
+            queue.push(std::move(payload));
+        },
+        [](auto& queue) {
+            while (queue.empty()) {
+                std::this_thread::yield();
+            }
+            return queue.poll();
+        });
+    std::cout << "PollingQueue: " << pollingTime << " ns per value\n";
+
+    measureSpscQueue<4>(); // As GameAI
+    measureSpscQueue<1024>();
+}
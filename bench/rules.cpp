@@ -0,0 +1,266 @@
+/**
+ * Micro-benchmarks of the rules of the game and of what the AI does at each node
+ *
+ * Each benchmark is run on the reference positions, from the beginning to the end
+ * of a game, given by their index. The checks are done for every character of the
+ * playing team towards every tile of the board.
+ *
+ * GameAI::functionEval is measured through evaluate, which does all its work, and
+ * the positions are found again through the transposition table, which the Zobrist
+ * hashes of the boards index.
+ */
+#include "action.h"
+#include "bitboard.h"
+#include "evaluation.h"
+#include "gameboard.h"
+#include "movelist.h"
+#include "referencepositions.h"
+#include "transpositiontable.h"
+
+#include <gf/Vector.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <cstdint>
+
+namespace {
+const int lastPosition = static_cast<int>(getReferencePositions().size()) - 1; ///< The index of the last reference position
+
+[[nodiscard]] Gameboard makeBoard(benchmark::State& state)
+{
+    const auto& position = getReferencePositions()[static_cast<std::size_t>(state.range(0))];
+    state.SetLabel(position.name);
+    return position.makeBoard();
+}
+
+[[nodiscard]] std::vector<gf::Vector2i> getTiles(const Gameboard& board)
+{
+    std::vector<gf::Vector2i> tiles{};
+    board.forEach([&tiles](auto pos) {
+        tiles.push_back(pos);
+    });
+    return tiles;
+}
+
+[[nodiscard]] std::vector<gf::Vector2i> getPlayingCharacters(const Gameboard& board)
+{
+    return board.getTeamPositions(board.getPlayingTeam());
+}
+
+/**
+ * Measure a check of the rules done from each character of the playing team towards each tile
+ */
+template<typename CheckFunc>
+void measureChecks(benchmark::State& state, CheckFunc check)
+{
+    const Gameboard board = makeBoard(state);
+    const auto origins = getPlayingCharacters(board);
+    const auto tiles = getTiles(board);
+
+    for (auto _ : state) {
+        for (const auto& origin : origins) {
+            for (const auto& tile : tiles) {
+                benchmark::DoNotOptimize(check(board, origin, tile));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(origins.size() * tiles.size()));
+}
+
+void benchCanMove(benchmark::State& state)
+{
+    measureChecks(state, [](const Gameboard& board, const gf::Vector2i& origin, const gf::Vector2i& tile) {
+        return static_cast<bool>(board.canMove(origin, tile));
+    });
+}
+
+void benchCanAttack(benchmark::State& state)
+{
+    measureChecks(state, [](const Gameboard& board, const gf::Vector2i& origin, const gf::Vector2i& tile) {
+        return static_cast<bool>(board.canAttack(origin, tile));
+    });
+}
+
+void benchCanUseCapacity(benchmark::State& state)
+{
+    measureChecks(state, [](const Gameboard& board, const gf::Vector2i& origin, const gf::Vector2i& tile) {
+        return static_cast<bool>(board.canUseCapacity(origin, tile));
+    });
+}
+
+/**
+ * getLastReachablePos is private, it is measured through the ejections, which follow the ejected characters
+ */
+void benchCapacityWillHurt(benchmark::State& state)
+{
+    measureChecks(state, [](const Gameboard& board, const gf::Vector2i& origin, const gf::Vector2i& tile) {
+        return board.capacityWillHurt(origin, tile);
+    });
+}
+
+void benchIsLocked(benchmark::State& state)
+{
+    const Gameboard board = makeBoard(state);
+    std::vector<gf::Vector2i> characters = board.getTeamPositions(PlayerTeam::Cthulhu);
+    const auto satanCharacters = board.getTeamPositions(PlayerTeam::Satan);
+    characters.insert(characters.end(), satanCharacters.begin(), satanCharacters.end());
+
+    for (auto _ : state) {
+        for (const auto& character : characters) {
+            benchmark::DoNotOptimize(board.isLocked(character));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(characters.size()));
+}
+
+void benchComputeBitRepresentation(benchmark::State& state)
+{
+    const Gameboard board = makeBoard(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(board.computeBitRepresentation());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Board>
+void benchGetPossibleActions(benchmark::State& state)
+{
+    const Board board{makeBoard(state)};
+
+    for (auto _ : state) {
+        MoveList actions{};
+        board.getPossibleActions(actions);
+        benchmark::DoNotOptimize(actions.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Measure the execution of each action of the playing team, on a copy of the board
+ */
+template<typename Board>
+void benchExecute(benchmark::State& state)
+{
+    const Board board{makeBoard(state)};
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    for (auto _ : state) {
+        for (const auto& action : actions) {
+            Board copy{board};
+            action.execute(copy);
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(actions.size()));
+}
+
+/**
+ * Measure the execution then the cancellation of each action of the playing team, as the search does
+ */
+template<typename Board>
+void benchExecuteReversibly(benchmark::State& state)
+{
+    Board board{makeBoard(state)};
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    for (auto _ : state) {
+        for (const auto& action : actions) {
+            auto record = action.executeReversibly(board);
+            benchmark::DoNotOptimize(board);
+            action.undo(board, record);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(actions.size()));
+}
+
+void benchEvaluate(benchmark::State& state)
+{
+    const Bitboard board{makeBoard(state)};
+    const EvalParams params{};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evaluate(board, board.getPlayingTeam(), params));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Measure the probes of a table filled with the states after each action, half of them found
+ */
+void benchTranspositionTableProbe(benchmark::State& state)
+{
+    Bitboard board{makeBoard(state)};
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    TranspositionTable table{};
+    std::vector<std::uint64_t> keys{};
+    std::mt19937_64 random{42};
+    for (const auto& action : actions) {
+        auto record = action.executeReversibly(board);
+        table.store(board.getHash(), 1, 0, Bound::Exact, action);
+        keys.push_back(board.getHash());
+        keys.push_back(random());
+        action.undo(board, record);
+    }
+
+    for (auto _ : state) {
+        for (auto key : keys) {
+            benchmark::DoNotOptimize(table.probe(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+/**
+ * Measure the storing of the states after each action, deeper each time
+ */
+void benchTranspositionTableStore(benchmark::State& state)
+{
+    Bitboard board{makeBoard(state)};
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    std::vector<std::uint64_t> keys{};
+    for (const auto& action : actions) {
+        auto record = action.executeReversibly(board);
+        keys.push_back(board.getHash());
+        action.undo(board, record);
+    }
+
+    TranspositionTable table{};
+    int depth = 0;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            table.store(keys[i], depth, 0, Bound::Exact, actions[i]);
+        }
+        depth = (depth + 1) % 32;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+} // namespace
+
+BENCHMARK(benchCanMove)->DenseRange(0, lastPosition);
+BENCHMARK(benchCanAttack)->DenseRange(0, lastPosition);
+BENCHMARK(benchCanUseCapacity)->DenseRange(0, lastPosition);
+BENCHMARK(benchCapacityWillHurt)->DenseRange(0, lastPosition);
+BENCHMARK(benchIsLocked)->DenseRange(0, lastPosition);
+BENCHMARK(benchComputeBitRepresentation)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchGetPossibleActions, Gameboard)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchGetPossibleActions, Bitboard)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchExecute, Gameboard)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchExecute, Bitboard)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchExecuteReversibly, Gameboard)->DenseRange(0, lastPosition);
+BENCHMARK_TEMPLATE(benchExecuteReversibly, Bitboard)->DenseRange(0, lastPosition);
+BENCHMARK(benchEvaluate)->DenseRange(0, lastPosition);
+BENCHMARK(benchTranspositionTableProbe)->DenseRange(0, lastPosition);
+BENCHMARK(benchTranspositionTableStore)->DenseRange(0, lastPosition);
+
+BENCHMARK_MAIN();
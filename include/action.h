@@ -5,20 +5,27 @@
 #ifndef ACTION_H
 #define ACTION_H
 
+#include "boardmask.h"
 #include "character.h"
+#include "undorecord.h"
 #include "utility.h"
 
 #include <gf/Vector.h>
 
+#include <iosfwd>
 #include <optional>
 
-class Gameboard;
+#include <cstdint>
 
 /**
  * Represent an action done by a character
  *
  * An action is a move followed by an attack or a capacity use
  *
+ * It only keeps the squares of its tiles (see BoardMask), so it fits in 32 bits and
+ * the lists of actions, the killer actions and the transposition table stay dense.
+ * It can also be packed into an integer, to be stored without padding.
+ *
  * \sa Character
  */
 class Action {
@@ -57,16 +64,38 @@ public:
      *
      * For example, an attack action is valid if the movement is not blocked, if it is
      * in the bounds and if there is an enemy character at the targeted position.
-     * \param board The board of the game
+     * \param board The board of the game, a Gameboard or a Bitboard
      * \return True if this action is valid, false otherwise
      */
-    [[nodiscard]] bool isValid(const Gameboard& board) const;
+    template<typename Board>
+    [[nodiscard]] bool isValid(const Board& board) const;
 
     /**
      * Execute this action. The character moves then attacks or uses a capacity
-     * \param board The board of the game
+     * \param board The board of the game, a Gameboard or a Bitboard
+     */
+    template<typename Board>
+    void execute(Board& board) const;
+
+    /**
+     * Execute this action and keep what is needed to cancel it
+     *
+     * It is used to explore the actions on a single board instead of copying it.
+     * \param board The board of the game, a Gameboard or a Bitboard
+     * \return The state of the tiles and the goals changed by this action, to give to undo
+     */
+    template<typename Board>
+    [[nodiscard]] UndoRecord executeReversibly(Board& board) const;
+
+    /**
+     * Cancel this action, after it has been executed by executeReversibly
+     *
+     * The notifications sent while executing the action are not cancelled.
+     * \param board The board the action has been executed on
+     * \param record The record given by executeReversibly
      */
-    void execute(Gameboard& board) const;
+    template<typename Board>
+    void undo(Board& board, const UndoRecord& record) const;
 
     [[nodiscard]] constexpr gf::Vector2i getDest() const;
     [[nodiscard]] constexpr gf::Vector2i getTarget() const;
@@ -74,15 +103,68 @@ public:
     [[nodiscard]] constexpr gf::Vector2i getOrigin() const;
     [[nodiscard]] constexpr gf::Vector2i getMove() const;
 
-    void display() const;
+    [[nodiscard]] constexpr int getOriginSquare() const;
+    [[nodiscard]] constexpr int getDestSquare() const;
+    [[nodiscard]] constexpr int getTargetSquare() const;
+
+    /**
+     * Give this action as an integer
+     *
+     * The squares of the origin, the destination and the target take 7 bits each,
+     * from the lowest bits, then the type takes 2 bits.
+     * \return The action in the packedBitCount lowest bits, the other ones are 0
+     */
+    [[nodiscard]] constexpr std::uint32_t pack() const;
+
+    /**
+     * Make an action from an integer
+     * \param bits An integer given by pack
+     * \return The action which has been packed, the same as before
+     */
+    [[nodiscard]] static constexpr Action unpack(std::uint32_t bits);
+
+    static constexpr unsigned packedBitCount = 23; ///< The number of bits used by a packed action
+
+    /**
+     * Write this action for humans, on a single line
+     * \param out The stream to write to
+     */
+    void display(std::ostream& out) const;
+
+    constexpr bool operator==(const Action& other) const;
+    constexpr bool operator!=(const Action& other) const;
 
 private:
+    /**
+     * Constructor
+     *
+     * \param type The type of this action
+     * \param origin The square of the character executing the action
+     * \param dest The square the character will move to
+     * \param target The square which is the attack/capacity destination
+     */
+    constexpr Action(ActionType type, int origin, int dest, int target);
+
+    static constexpr unsigned squareBitCount = 7; ///< Enough for the squares of the board
+    static constexpr std::uint32_t squareMask = (1U << squareBitCount) - 1;
+
+    static_assert(BoardMask::squareCount <= (1 << squareBitCount), "The squares must fit in the bits of a packed action");
+    static_assert(3 * squareBitCount + 2 == packedBitCount, "The packed action must hold the squares and the type");
+
     ActionType m_type; ///< The type of this action
-    gf::Vector2i m_origin; ///< The position of the character who is doing this action
-    gf::Vector2i m_dest; ///< The destination position of the character
-    gf::Vector2i m_target; ///< The attack/capacity targeted position
+    std::int8_t m_origin; ///< The square of the character who is doing this action
+    std::int8_t m_dest; ///< The destination square of the character
+    std::int8_t m_target; ///< The attack/capacity targeted square
 };
 
+static_assert(sizeof(Action) == 4, "An action must stay as small as its packed form");
+
+/**
+ * Write an action for humans
+ * \sa Action::display
+ */
+inline std::ostream& operator<<(std::ostream& out, const Action& action);
+
 #include "impl/action.h"
 
 #endif // ACTION_H
@@ -0,0 +1,46 @@
+/**
+ * A file defining the queue of the animations to play after the board has changed
+ */
+#ifndef ANIMATIONQUEUE_H
+#define ANIMATIONQUEUE_H
+
+#include "boardobserver.h"
+
+#include <gf/Vector.h>
+
+#include <functional>
+#include <queue>
+
+/**
+ * Keep the changes of a board to show them one after the other
+ *
+ * \sa GameboardView::notifyMove, GameboardView::notifyHP
+ */
+class AnimationQueue : public BoardObserver {
+public:
+    void notifyMove(const gf::Vector2i& origin, const gf::Vector2i& dest) override;
+    void notifyHP(const gf::Vector2i& pos, int hp) override;
+
+    template<typename BinaryFunc>
+    inline void setMoveCallback(BinaryFunc f);
+
+    template<typename BinaryFunc>
+    inline void setHPChangeCallback(BinaryFunc f);
+
+    [[nodiscard]] inline bool isCallbackNeeded() const;
+
+    /**
+     * Call the callback of the oldest change
+     */
+    inline void doFirstCallback();
+
+private:
+    std::function<void(const gf::Vector2i&, const gf::Vector2i&)> m_moveCallback = [](auto, auto) {};
+    std::function<void(const gf::Vector2i&, int)> m_hpChangeCallback = [](auto, auto) {};
+
+    std::queue<std::function<void()>> m_lastActions{};
+};
+
+#include "impl/animationqueue.h"
+
+#endif // ANIMATIONQUEUE_H
@@ -0,0 +1,288 @@
+/**
+ * A file containing a compact version of the game's board, used by the AI
+ */
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "boardmask.h"
+#include "character.h"
+#include "gameboard.h"
+#include "utility.h"
+#include "zobrist.h"
+
+#include <gf/Vector.h>
+
+#include <array>
+
+#include <cstdint>
+
+class Action;
+class MoveList;
+class UndoRecord;
+
+/**
+ * A game's board where the characters are stored as sets of tiles
+ *
+ * It follows exactly the same rules as the Gameboard, but it is cheap to copy
+ * and to query. It does not notify anything when a character moves or is hurt.
+ *
+ * \sa Gameboard
+ */
+class Bitboard {
+public:
+    /**
+     * Constructor
+     *
+     * Make the board at the beginning of the game
+     */
+    explicit Bitboard();
+
+    /**
+     * Constructor
+     *
+     * \param board The board to copy the state from
+     */
+    explicit Bitboard(const Gameboard& board);
+
+    /**
+     * Give all the actions a character can do
+     * \param origin The position of the character to get its actions
+     * \param actions The list where the possible actions are added
+     */
+    void getPossibleActions(const gf::Vector2i& origin, MoveList& actions) const;
+
+    /**
+     * Give all the actions the playing team can do
+     * \param actions The list where the possible actions are added
+     */
+    void getPossibleActions(MoveList& actions) const;
+
+    /**
+     * Attack another character
+     *
+     * \param origin The position of the attacking character
+     * \param dest The position of the character to attack
+     * \return True if the attack succeeds
+     *
+     * \sa Gameboard::attack
+     */
+    bool attack(const gf::Vector2i& origin, const gf::Vector2i& dest);
+
+    /**
+     * Tell if the character can attack another one
+     *
+     * \sa Gameboard::canAttack
+     */
+    [[nodiscard]] Ability canAttack(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& executor) const;
+    [[nodiscard]] inline Ability canAttack(const gf::Vector2i& origin, const gf::Vector2i& dest) const;
+
+    [[nodiscard]] bool isLocked(const gf::Vector2i& pos) const;
+
+    /**
+     * Move this character
+     *
+     * \param origin The position of the character
+     * \param dest The position where the character tries to move
+     * \return True if the character has moved
+     *
+     * \sa Gameboard::move
+     */
+    bool move(const gf::Vector2i& origin, const gf::Vector2i& dest);
+
+    /**
+     * Tell if this character can move from a position to another
+     *
+     * \sa Gameboard::canMove
+     */
+    [[nodiscard]] inline Ability canMove(const gf::Vector2i& origin, const gf::Vector2i& dest) const;
+
+    /**
+     * Use the character's capacity
+     *
+     * \param origin The position of the character using its capacity
+     * \param dest The position of target of the capacity
+     * \return True if the capacity succeeds
+     *
+     * \sa Gameboard::useCapacity
+     */
+    bool useCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest);
+
+    /**
+     * Tell if this character can use its capacity along a given vector
+     *
+     * \sa Gameboard::canUseCapacity
+     */
+    [[nodiscard]] Ability canUseCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& executor) const;
+    [[nodiscard]] inline Ability canUseCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest) const;
+
+    [[nodiscard]] inline bool capacityWillHurt(const gf::Vector2i& origin, const gf::Vector2i& dest) const;
+
+    /**
+     * Give the enemies a team can attack without moving
+     *
+     * All the characters of the team are handled at once, by shifting the sets of tiles.
+     *
+     * \param team The attacking team
+     * \return The set of the tiles of the characters for which canAttack is true from a character of the team
+     */
+    [[nodiscard]] BoardMask getAttackedMask(PlayerTeam team) const;
+
+    /**
+     * Give the characters the Supports of a team would hurt with their capacity without moving
+     *
+     * All the Supports of the team are handled at once, by shifting the sets of tiles.
+     *
+     * \param team The team of the Supports
+     * \return The set of the tiles of the characters, in both teams, for which capacityWillHurt is true from a Support of the team
+     */
+    [[nodiscard]] BoardMask getCapacityHurtMask(PlayerTeam team) const;
+
+    [[nodiscard]] inline bool isEmpty(const gf::Vector2i& tile) const;
+    [[nodiscard]] inline bool isOccupied(const gf::Vector2i& tile) const;
+
+    [[nodiscard]] inline Character getCharacter(const gf::Vector2i& tile) const;
+
+    [[nodiscard]] constexpr gf::Vector2i getSize() const;
+
+    [[nodiscard]] inline PlayerTeam getTeamFor(const gf::Vector2i& tile) const;
+    [[nodiscard]] inline CharacterType getTypeFor(const gf::Vector2i& tile) const;
+    [[nodiscard]] inline int getHPFor(const gf::Vector2i& tile) const;
+
+    /**
+     * Give the tiles occupied by a team
+     * \param team The team of the characters
+     * \return The set of the tiles of the characters
+     */
+    [[nodiscard]] inline BoardMask getTeamMask(PlayerTeam team) const;
+
+    /**
+     * Give the tiles occupied by a type of character
+     * \param type The type of the characters, in both teams
+     * \return The set of the tiles of the characters
+     */
+    [[nodiscard]] inline BoardMask getTypeMask(CharacterType type) const;
+
+    /**
+     * Give all the occupied tiles
+     * \return The set of the tiles of every character
+     */
+    [[nodiscard]] inline BoardMask getOccupiedMask() const;
+
+    [[nodiscard]] constexpr PlayerTeam getPlayingTeam() const;
+
+    /**
+     * Switch turn
+     */
+    constexpr void switchTurn();
+
+    /**
+     * Tell if a goal is activated
+     *
+     * \param index The index of the goal, in the order of Gameboard::goalLayout
+     * \return True if the goal has been activated
+     */
+    [[nodiscard]] inline bool isGoalActivated(std::size_t index) const;
+
+    [[nodiscard]] int getNbOfActivatedGoals(PlayerTeam team) const;
+
+    /**
+     * Give the activated goals
+     * \return One bit for each goal of Gameboard::goalLayout
+     */
+    [[nodiscard]] inline std::uint8_t getActivatedGoals() const;
+
+    /**
+     * Put back the tiles and the goals as they were before an action
+     * \param record The record given by Action::executeReversibly
+     */
+    void restore(const UndoRecord& record);
+
+    [[nodiscard]] std::array<int, 2 * Gameboard::goalsPerTeam> getGoalsDistance(const gf::Vector2i& pos) const;
+
+    /**
+     * Give how far the team of a goal is from it
+     *
+     * \param index The index of the goal, in the order of Gameboard::goalLayout
+     * \return The Manhattan distance from the goal to the nearest character of its team, 0 if the goal is activated
+     */
+    [[nodiscard]] int getGoalDistance(std::size_t index) const;
+
+    /**
+     * Give the HP lost by the living characters of a team
+     *
+     * It is kept up to date after each change, so it costs nothing to get.
+     * \param team The team of the characters
+     * \return The sum of the HP lost by each character
+     */
+    [[nodiscard]] constexpr int getDamage(PlayerTeam team) const;
+
+    [[nodiscard]] inline bool hasWon(PlayerTeam team) const;
+
+    /**
+     * Give the Zobrist hash of this board
+     *
+     * It is kept up to date after each change, so it costs nothing to get.
+     * \return The same hash as the Gameboard with the same state
+     */
+    [[nodiscard]] constexpr std::uint64_t getHash() const;
+
+    inline bool operator==(const Bitboard& other) const;
+
+private:
+    void put(const gf::Vector2i& tile, const Character& character);
+    void remove(const gf::Vector2i& tile);
+
+    void tryGoalActivation(PlayerTeam team, const gf::Vector2i& position);
+
+    void swapPositions(const gf::Vector2i& origin, const gf::Vector2i& dest);
+
+    [[nodiscard]] Ability canMove(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& /*executor*/) const;
+
+    /**
+     * Give the tiles a character can move to
+     *
+     * \param origin The position of the character
+     * \return The set of the tiles for which canMove is Ability::Able, the origin included
+     */
+    [[nodiscard]] BoardMask getMoveMask(const gf::Vector2i& origin) const;
+
+    /**
+     * Give the tiles a character could attack from a tile, whatever is on them
+     *
+     * \param type The type of the attacking character, which stays on its tile
+     * \param pos The position the character attacks from
+     * \return The set of the tiles in range, not hidden behind another character
+     */
+    [[nodiscard]] BoardMask getAttackMask(CharacterType type, const gf::Vector2i& pos) const;
+
+    /**
+     * Give the tiles a character can use its capacity on from a tile
+     *
+     * \param type The type of the character, which stays on its tile
+     * \param pos The position the character uses its capacity from
+     * \return The set of the tiles for which canUseCapacity is Ability::Able
+     */
+    [[nodiscard]] BoardMask getCapacityMask(CharacterType type, const gf::Vector2i& pos) const;
+
+    [[nodiscard]] gf::Vector2i getLastReachablePos(const gf::Vector2i& origin, const gf::Vector2i& dest, bool excludeDest = false) const;
+    [[nodiscard]] inline bool isTargetReachable(const gf::Vector2i& origin, const gf::Vector2i& dest, bool excludeDest = false) const;
+
+    /**
+     * Hurt a character and remove it if its HP have fallen to 0
+     * \param target The position of the character
+     * \param amount The amount of damage
+     */
+    void damage(const gf::Vector2i& target, int amount);
+
+    std::array<BoardMask, 2> m_teams{}; ///< The tiles of each team
+    std::array<BoardMask, 3> m_types{}; ///< The tiles of each type of character
+    std::array<std::int8_t, BoardMask::squareCount> m_hp{}; ///< The HP of the character on each tile
+    std::uint8_t m_activatedGoals{0}; ///< One bit for each goal of Gameboard::goalLayout
+    PlayerTeam m_playingTeam{PlayerTeam::Cthulhu};
+    std::uint64_t m_hash{0}; ///< The Zobrist hash of all of the above
+    std::array<int, 2> m_damage{}; ///< The HP lost by the characters of each team
+};
+
+#include "impl/bitboard.h"
+
+#endif // BITBOARD_H
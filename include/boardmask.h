@@ -0,0 +1,169 @@
+/**
+ * A file defining a set of tiles of the game's board, stored as bits
+ */
+#ifndef BOARDMASK_H
+#define BOARDMASK_H
+
+#include <gf/Vector.h>
+
+#include <cstdint>
+
+/**
+ * A set of tiles of the 12x6 board
+ *
+ * Each tile is a bit, the tile (x, y) being the bit y * width + x.
+ * The 72 bits are split in two words: tiles 0 to 63 and tiles 64 to 71.
+ */
+class BoardMask {
+public:
+    static constexpr int width = 12; ///< The number of columns of the board
+    static constexpr int height = 6; ///< The number of rows of the board
+    static constexpr int squareCount = width * height; ///< The number of tiles of the board
+
+    /**
+     * Constructor
+     *
+     * Make an empty set
+     */
+    constexpr BoardMask() = default;
+
+    /**
+     * Make a set with only one tile
+     *
+     * \param square The index of the tile
+     * \return The set containing the tile
+     */
+    [[nodiscard]] static constexpr BoardMask fromSquare(int square);
+
+    /**
+     * Make the set of all the tiles of the board
+     * \return The full set
+     */
+    [[nodiscard]] static constexpr BoardMask full();
+
+    /**
+     * Make the set of all the tiles of a column
+     *
+     * \param x The column
+     * \return The set of the tiles in the column
+     */
+    [[nodiscard]] static constexpr BoardMask column(int x);
+
+    /**
+     * Tell if a position is inside the board
+     *
+     * \param pos The position to check
+     * \return True if the position is a tile of the board
+     */
+    [[nodiscard]] static constexpr bool isValid(const gf::Vector2i& pos);
+
+    /**
+     * Give the index of the tile at a position
+     *
+     * \param pos A valid position
+     * \return The index of the tile
+     */
+    [[nodiscard]] static constexpr int toSquare(const gf::Vector2i& pos);
+
+    /**
+     * Give the position of a tile
+     *
+     * \param square The index of the tile
+     * \return The position of the tile
+     */
+    [[nodiscard]] static constexpr gf::Vector2i toPosition(int square);
+
+    /**
+     * Give the tiles from a tile to the edge of the board, in a direction
+     *
+     * \param square The index of the starting tile, which is not in the set
+     * \param direction The direction, whose coordinates are -1, 0 or 1
+     * \return The set of the tiles of the ray, empty for the null direction
+     */
+    [[nodiscard]] static constexpr BoardMask ray(int square, const gf::Vector2i& direction);
+
+    /**
+     * Give the tiles strictly between two tiles of the same row, column or diagonal
+     *
+     * \param origin A valid position
+     * \param dest A valid position
+     * \return The set of the tiles between them, empty if they are not aligned
+     */
+    [[nodiscard]] static constexpr BoardMask between(const gf::Vector2i& origin, const gf::Vector2i& dest);
+
+    [[nodiscard]] constexpr bool test(int square) const;
+    constexpr void set(int square);
+    constexpr void reset(int square);
+
+    [[nodiscard]] constexpr bool any() const;
+    [[nodiscard]] constexpr bool none() const;
+
+    /**
+     * Count the tiles in this set
+     * \return The number of bits set
+     */
+    [[nodiscard]] constexpr int count() const;
+
+    /**
+     * Give the smallest tile of this set
+     * \return The index of the first tile, this set must not be empty
+     */
+    [[nodiscard]] constexpr int first() const;
+
+    /**
+     * Give the largest tile of this set
+     * \return The index of the last tile, this set must not be empty
+     */
+    [[nodiscard]] constexpr int last() const;
+
+    /**
+     * Remove the smallest tile of this set
+     * \return The index of the removed tile, this set must not be empty
+     */
+    constexpr int popFirst();
+
+    /**
+     * Move every tile of this set
+     *
+     * Tiles moved outside of the board are removed, they do not wrap
+     * around to the next row.
+     *
+     * \param dx The horizontal displacement
+     * \param dy The vertical displacement
+     * \return The moved set
+     */
+    [[nodiscard]] constexpr BoardMask shifted(int dx, int dy) const;
+
+    /**
+     * Give the tiles orthogonally adjacent to the tiles of this set
+     * \return The set of the neighbours
+     */
+    [[nodiscard]] constexpr BoardMask orthogonalNeighbours() const;
+
+    constexpr BoardMask operator~() const;
+    constexpr BoardMask& operator&=(const BoardMask& other);
+    constexpr BoardMask& operator|=(const BoardMask& other);
+    constexpr BoardMask& operator^=(const BoardMask& other);
+
+    constexpr bool operator==(const BoardMask& other) const;
+    constexpr bool operator!=(const BoardMask& other) const;
+
+private:
+    static constexpr int lowBitCount = 64;
+    static constexpr std::uint64_t highWordMask = (std::uint64_t{1} << (squareCount - lowBitCount)) - 1;
+
+    constexpr BoardMask(std::uint64_t low, std::uint64_t high);
+
+    [[nodiscard]] constexpr BoardMask shiftedBits(int offset) const;
+
+    std::uint64_t m_low{0}; ///< The tiles 0 to 63
+    std::uint64_t m_high{0}; ///< The tiles 64 to 71
+};
+
+constexpr BoardMask operator&(BoardMask lhs, const BoardMask& rhs);
+constexpr BoardMask operator|(BoardMask lhs, const BoardMask& rhs);
+constexpr BoardMask operator^(BoardMask lhs, const BoardMask& rhs);
+
+#include "impl/boardmask.h"
+
+#endif // BOARDMASK_H
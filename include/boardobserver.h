@@ -0,0 +1,39 @@
+/**
+ * A file defining the interface of what follows the changes of a board
+ */
+#ifndef BOARDOBSERVER_H
+#define BOARDOBSERVER_H
+
+#include <gf/Vector.h>
+
+/**
+ * Something notified when a character moves or when its HP change
+ *
+ * The rules of the board do not depend on it: a board without
+ * observer, like the ones used by the AI, notifies nothing.
+ *
+ * \sa Gameboard::setObserver
+ */
+class BoardObserver {
+public:
+    /**
+     * Default virtual destructor
+     */
+    virtual ~BoardObserver() noexcept = default;
+
+    /**
+     * A character has moved
+     * \param origin The previous position of the character
+     * \param dest The new position of the character
+     */
+    virtual void notifyMove(const gf::Vector2i& origin, const gf::Vector2i& dest) = 0;
+
+    /**
+     * The HP of a character have changed
+     * \param pos The position of the character
+     * \param hp The new HP of the character
+     */
+    virtual void notifyHP(const gf::Vector2i& pos, int hp) = 0;
+};
+
+#endif // BOARDOBSERVER_H
@@ -65,7 +65,6 @@ public:
 
     [[nodiscard]] static constexpr int getGlobalHPMax();
 
-private:
     /**
      * Give the maximum amount of HP according to the type of character
      *
@@ -82,6 +81,7 @@ private:
      */
     [[nodiscard]] static constexpr int getDamageForType(CharacterType type);
 
+private:
     PlayerTeam m_team; ///< The team this character belongs to
     CharacterType m_type; ///< This character's type
 
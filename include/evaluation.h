@@ -0,0 +1,71 @@
+/**
+ * A file defining how the AI scores a state of the game
+ */
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "bitboard.h"
+#include "utility.h"
+
+#include <array>
+#include <string>
+#include <utility>
+
+/**
+ * The weights of the terms of the evaluation
+ *
+ * They can be read from and written to a text file, with one "name value" pair per line.
+ * The lines starting with '#' are comments.
+ *
+ * \sa evaluate
+ */
+struct EvalParams {
+    int damage{15}; ///< For each HP lost by the enemies
+    int threat{5}; ///< For each enemy the team can attack, minus for each ally the enemies can attack
+    int hurtingCapacity{8}; ///< For each enemy the Supports can hurt with their capacity, minus for each ally
+    int activatedGoal{1000}; ///< For each goal activated by the team, minus for each goal activated by the enemies
+    int deadCharacter{130}; ///< For each dead enemy, minus for each dead ally
+    int goalProximity{1}; ///< For each goal of the team, for each tile its nearest character is closer than the farthest tile
+
+    /**
+     * The name and the member of each weight
+     * \return The list of all the weights
+     */
+    [[nodiscard]] static constexpr std::array<std::pair<const char*, int EvalParams::*>, 6> getFields();
+
+    /**
+     * Read the weights from a file
+     *
+     * The weights missing from the file keep their value.
+     * If the file can not be read, none of the weights is changed.
+     *
+     * \param path The path of the file
+     * \return False if the file can not be read or contains an unknown weight
+     */
+    [[nodiscard]] bool loadFromFile(const std::string& path);
+
+    /**
+     * Write the weights to a file
+     *
+     * \param path The path of the file
+     * \return False if the file can not be written
+     */
+    [[nodiscard]] bool saveToFile(const std::string& path) const;
+};
+
+/**
+ * Give a score to a state for a team
+ *
+ * The score is the sum of the weighted terms of the state. The states
+ * which are nearly won or lost are not handled specially.
+ *
+ * \param board The board to score
+ * \param team The team the score is for
+ * \param params The weights of the terms
+ * \return The score of the state, higher when the team is doing better
+ */
+[[nodiscard]] long evaluate(const Bitboard& board, PlayerTeam team, const EvalParams& params);
+
+#include "impl/evaluation.h"
+
+#endif // EVALUATION_H
@@ -5,6 +5,7 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "animationqueue.h"
 #include "gameai.h"
 #include "gameboard.h"
 #include "humanplayer.h"
@@ -92,6 +93,13 @@ private:
     void initWidgets();
     void initSprites();
 
+    /**
+     * Give how the AI searches, with the weights of its evaluation read from the assets
+     * \param resMgr The resource manager where the weights are searched
+     * \return The settings of the AI
+     */
+    [[nodiscard]] static SearchSettings loadSearchSettings(gf::ResourceManager& resMgr);
+
     [[nodiscard]] inline bool isFromTeam(const gf::Vector2i& tile, PlayerTeam team) const;
 
     void stateSelectionUpdate(PlayerTurnSelection nextState);
@@ -153,11 +161,12 @@ private:
     gf::Clock m_clock{};
 
     HumanPlayer m_humanPlayer{PlayerTeam::Cthulhu};
-    GameAI m_aiPlayer{PlayerTeam::Satan};
+    GameAI m_aiPlayer{PlayerTeam::Satan, loadSearchSettings(*m_resMgr)};
 
     std::optional<gf::Vector2i> m_selectedPos;
 
-    std::unique_ptr<GameboardView> m_gbView{nullptr}; // Deleted after gameboard because of callbacks
+    std::unique_ptr<GameboardView> m_gbView{nullptr}; // Deleted after the animations because of callbacks
+    AnimationQueue m_animations{};
     Gameboard m_board{};
 
     std::set<gf::Vector2i, PositionComp> m_possibleTargets;
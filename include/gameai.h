@@ -6,63 +6,288 @@
 #define GAMEAI_H
 
 #include "action.h"
+#include "bitboard.h"
+#include "evaluation.h"
 #include "gameboard.h"
+#include "movelist.h"
+#include "moveordering.h"
 #include "player.h"
-#include "pollingqueue.h"
+#include "searchstats.h"
+#include "spscqueue.h"
+#include "timecontrol.h"
+#include "transpositiontable.h"
 #include "utility.h"
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * The settings of the AI search
+ */
+struct SearchSettings {
+    std::chrono::milliseconds timeBudget{1000}; ///< The longest time given to search each move
+    std::size_t transpositionTableSize{TranspositionTable::defaultSize}; ///< The size of the table of the searched positions, in MB
+    unsigned threadCount{0}; ///< The number of threads searching together, 0 to use every core
+    EvalParams evalParams{}; ///< The weights of the evaluation of the states
+    bool ponder{true}; ///< If the AI searches its answer to the predicted enemy's action while the enemy team is playing
+};
 
 /**
  * The artificial intelligence class
  *
- * This AI is based on the alpha-beta algorithm
+ * This AI is based on the alpha-beta algorithm, in its negamax form,
+ * with iterative deepening until the time given for a move is over (see TimeControl).
+ *
+ * Several threads search the same position at the same time and share
+ * their results through the transposition table (Lazy SMP).
+ *
+ * While the enemy team plays, the AI predicts the enemy's action and
+ * searches its answer to it (pondering), until the enemy's board is given.
  */
 class GameAI : public Player {
 public:
     /**
      * Constructor
      * \param team The team the AI controls
+     * \param settings How the AI searches its actions
      */
-    explicit inline GameAI(PlayerTeam team);
+    explicit inline GameAI(PlayerTeam team, const SearchSettings& settings = SearchSettings{});
     virtual inline ~GameAI() noexcept;
 
     inline void askToPlay(const Gameboard& board);
 
     void tryToPlay(Gameboard& board);
 
+    /**
+     * Wait for the action of the AI, then do it on the board
+     *
+     * It is the blocking version of tryToPlay, for the games without display.
+     *
+     * \param board The board the AI plays on, given to askToPlay
+     */
+    void waitToPlay(Gameboard& board);
+
+    /**
+     * Give the statistics of the search of the last action sent by the AI
+     *
+     * They are only counted if the SEARCH_STATS macro is defined.
+     * \return The statistics of the search
+     */
+    [[nodiscard]] SearchStats getLastSearchStats() const;
+
 private:
-    using depthActionsExploration = std::pair<Action, std::pair<long, long>>; // FIXME Maybe tuple or struct?
+    static constexpr long winScore = 9999; ///< The score of a game won now, minus one for each turn before it is won
+    static constexpr long minWinScore = winScore - MoveOrdering::maxPly; ///< The score of the slowest win the search can find
+    static constexpr long maxEvalScore = minWinScore - 1; ///< The score of a nearly won state, below the scores of won games
+    static constexpr long infiniteScore = 10000; ///< More than any score
+    static constexpr long aspirationWindow = 50; ///< How far the score of an iteration is expected from the previous one
+    static constexpr int maxDepth = 64; ///< The deepest iteration of the search
+    static constexpr int maxQuiescenceDepth = 2; ///< The number of turns searched by the quiescence search
 
     /**
-     * Give a score to a state (9999 means win and -9999 means defeat
+     * Tell if a score is the score of a won or lost game
+     * \param score The score to check
+     * \return True if the score is a win or a defeat in a few turns
+     */
+    [[nodiscard]] static constexpr bool isWinScore(long score);
+
+    /**
+     * Make a score independent of the distance from the root, to be stored in the transposition table
+     *
+     * The wins are stored as the number of turns from the stored state instead of from the root.
+     *
+     * \param score The score given by the search
+     * \param ply The distance from the root
+     * \return The score to store
+     */
+    [[nodiscard]] static constexpr long scoreToTable(long score, int ply);
+
+    /**
+     * Make a score of the transposition table relative to the root
+     * \param score The stored score
+     * \param ply The distance from the root
+     * \return The score for the search
+     * \sa scoreToTable
+     */
+    [[nodiscard]] static constexpr long scoreFromTable(long score, int ply);
+
+    /**
+     * Give a score to a state (maxEvalScore means nearly won and -maxEvalScore means nearly lost)
+     *
+     * \sa evaluate
      *
      * \param board Board game
-     * \return Score of the actual configuration
+     * \return Score of the actual configuration, for the team of this AI, between -maxEvalScore and maxEvalScore
      */
-    long functionEval(const Gameboard& board);
+    long functionEval(const Bitboard& board);
 
     /**
-     * The first int correspond to the depth of the configuration.
-     * Pair is for the human player
-     * Impair is for the AI player
-     * @param board
-     * @param depth
-     * @return
+     * Give a score to a state for the team which plays
+     * \param board Board game
+     * \return The score given by functionEval, negated if the enemy team plays
      */
-    depthActionsExploration bestActionInFuture(const Gameboard& board, unsigned int depth);
+    [[nodiscard]] long evaluateForPlayingTeam(const Bitboard& board);
+
+    /**
+     * What each search thread keeps for itself
+     */
+    struct SearchThread {
+        MoveOrdering moveOrdering{};
+        std::uint64_t nodeCount{0}; ///< The number of positions searched by the current search
+        int completedDepth{0}; ///< The depth of the last completed iteration
+        long score{0}; ///< The score of the last completed iteration
+        std::optional<Action> bestAction{}; ///< The best action of the last completed iteration
+        SearchStats stats{}; ///< What this thread has done during the current search
+    };
+
+    /**
+     * Find the best action of the playing team
+     *
+     * All the search threads search the position until the time control stops the main thread,
+     * then the action of the deepest completed iteration is given.
+     * The search also stops when a new board is given or the game is closed.
+     *
+     * \param board The board to search from
+     * \param timeControl The time given to the search, without limit to search until a new board is given
+     * \return The best action found
+     */
+    [[nodiscard]] Action searchBestAction(const Gameboard& board, const TimeControl& timeControl);
+
+    /**
+     * Search a position, deeper and deeper, until the search is stopped
+     *
+     * The search is deepened one turn at a time, starting with the best action of the
+     * previous iteration. The helper threads start at different depths and with the
+     * actions in a different order, so they do not all search the same nodes.
+     *
+     * \param thread The state of the thread
+     * \param index The index of the thread, 0 for the main thread
+     * \param board The board to search from
+     */
+    void iterativeDeepening(SearchThread& thread, std::size_t index, const Bitboard& board);
+
+    /**
+     * Search all the actions of the root of the search
+     *
+     * The best action is moved to the front of the list, unless no action is better than alpha.
+     *
+     * \param thread The state of the thread searching
+     * \param board The board to search
+     * \param rootActions The actions of the root, the best one of the previous search first
+     * \param depth The number of turns to search
+     * \param alpha The lower bound of the aspiration window
+     * \param beta The upper bound of the aspiration window
+     * \return The score of the best action, or 0 if the search has been aborted
+     */
+    long searchRoot(SearchThread& thread, Bitboard& board, MoveList& rootActions, int depth, long alpha, long beta);
+
+    /**
+     * Search the state after an action (principal variation search)
+     *
+     * The first action is searched with the full window. The next ones are expected to be
+     * worse, which is proved with a null window, and searched again with the full window if not.
+     *
+     * \param thread The state of the thread searching
+     * \param board The board to do the action on, the same at the end
+     * \param action The action to search
+     * \param depth The number of turns to search, including the action
+     * \param ply The distance from the root of the board before the action
+     * \param alpha The score the playing team is already sure to get
+     * \param beta The score the enemy team is already sure to limit the playing team to
+     * \param isFirst If the action is the first one searched from the board
+     * \return The score of the action for the playing team
+     */
+    long searchAction(SearchThread& thread, Bitboard& board, const Action& action, int depth, int ply, long alpha, long beta, bool isFirst);
+
+    /**
+     * Search a position with the negamax form of the alpha-beta algorithm
+     *
+     * The search is done on a Bitboard, which is much cheaper to copy and to query than a Gameboard.
+     * The actions are executed then undone on the given board, which is the same at the end.
+     *
+     * \param thread The state of the thread searching
+     * \param board The board to search
+     * \param depth The number of turns to search
+     * \param ply The number of turns from the root of the search
+     * \param alpha The score the playing team is already sure to get
+     * \param beta The score the enemy team is already sure to limit the playing team to
+     * \return The score of the position for the playing team, or 0 if the search has been aborted
+     */
+    long alphaBeta(SearchThread& thread, Bitboard& board, int depth, int ply, long alpha, long beta);
+
+    /**
+     * Search the actions which hurt an enemy, until the state is quiet
+     *
+     * It is done at the leaves of the alpha-beta search, so an attack or an ejection
+     * just after the last searched turn is not missed (horizon effect).
+     * As the playing team could do a quiet action instead, the score of the state
+     * is a lower bound of the score of the playing team (stand pat).
+     *
+     * \param thread The state of the thread searching
+     * \param board The board to search
+     * \param depth The number of turns still searched, as both teams can usually attack every turn
+     * \param ply The number of turns from the root of the search
+     * \param alpha The score the playing team is already sure to get
+     * \param beta The score the enemy team is already sure to limit the playing team to
+     * \return The score of the position for the playing team, or 0 if the search has been aborted
+     */
+    long quiescence(SearchThread& thread, Bitboard& board, int depth, int ply, long alpha, long beta);
+
+    /**
+     * Tell if the search must stop now, because the time is over, a new board is given or the game is closed
+     *
+     * The clock is only checked by the main thread, every few nodes, once it has completed an iteration.
+     * \param thread The state of the thread searching
+     */
+    [[nodiscard]] bool isSearchAborted(const SearchThread& thread);
 
     /**
      * Simulate the actions
+     *
+     * The actions are computed when needed, then the thread sleeps until a new board is given.
      */
     void simulateActions();
 
+    /**
+     * Do an action of the AI and give it to the game
+     * \param board The board to play on
+     * \param action The action to play
+     */
+    void sendAction(Gameboard& board, Action action);
+
+    /**
+     * Guess the action the enemy is going to do
+     * \param board The board the enemy plays on
+     * \return The best action of the enemy, known from the previous search or searched
+     */
+    [[nodiscard]] Action predictEnemyAction(const Gameboard& board);
+
     std::atomic_bool m_gameOpen{true};
 
-    std::thread m_computingThread{&GameAI::simulateActions, this};
-    PollingQueue<Gameboard> m_threadInput{};
-    PollingQueue<Action> m_threadOutput{};
+    std::chrono::milliseconds m_timeBudget;
+    EvalParams m_evalParams;
+    bool m_ponder;
+    TranspositionTable m_transpositionTable; ///< Shared by the search threads, which are started after it
+    std::vector<SearchThread> m_searchThreads; ///< The first one is the computing thread
+
+    TimeControl m_timeControl{}; ///< The time given to the current search, only used by the main thread
+    TimeControl::Clock::time_point m_searchStart{}; ///< When the current search started, only used by the main thread
+    std::atomic_bool m_stopSearch{false};
+
+    SpscQueue<Gameboard, 4> m_threadInput{}; ///< Closed with the game
+    SpscQueue<Action, 4> m_threadOutput{};
+
+    SearchStats m_searchStats{}; ///< The statistics of the last search, only used by the computing thread
+    SearchStats m_lastSearchStats{}; ///< The statistics of the search of the last action sent
+    mutable std::mutex m_lastSearchStatsMutex{};
+
+    std::thread m_computingThread{&GameAI::simulateActions, this}; ///< Started last, once everything it uses is constructed
 };
 
 #include "impl/gameai.h"
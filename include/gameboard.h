@@ -7,18 +7,26 @@
 #ifndef CTHULHUVSSATAN_GAMEBOARD_H
 #define CTHULHUVSSATAN_GAMEBOARD_H
 
+#include "boardobserver.h"
 #include "character.h"
 #include "goal.h"
+#include "targettables.h"
+#include "zobrist.h"
 
 #include <gf/Array2D.h>
 
-#include <functional>
+#include <array>
+#include <iosfwd>
 #include <optional>
-#include <queue>
 #include <set>
 #include <vector>
 
+#include <cstdint>
+
 class Action;
+class MoveList;
+class UndoRecord;
+class Bitboard;
 
 class Ability {
 public:
@@ -50,8 +58,58 @@ public:
     constexpr static int goalsPerTeam = 2;
     constexpr static int charactersPerTeam = 6;
 
+    /**
+     * The goals of both teams, as they are at the beginning of the game
+     */
+    constexpr static std::array<Goal, 2 * goalsPerTeam> goalLayout{
+            Goal{PlayerTeam::Cthulhu, {10, 1}},
+            Goal{PlayerTeam::Cthulhu, {10, 4}},
+            Goal{PlayerTeam::Satan, {1, 1}},
+            Goal{PlayerTeam::Satan, {1, 4}},
+    };
+
     explicit Gameboard();
 
+    /**
+     * Constructor
+     *
+     * \param board The compact board to copy the state from
+     */
+    explicit Gameboard(const Bitboard& board);
+
+    /**
+     * Copy constructor
+     *
+     * The copy has no observer, so it can be played on without notifying anything
+     */
+    Gameboard(const Gameboard& other);
+
+    /**
+     * Move constructor
+     *
+     * As a copy, the new board has no observer
+     */
+    Gameboard(Gameboard&& other) noexcept;
+
+    /**
+     * Copy
+     *
+     * This board keeps its own observer
+     */
+    Gameboard& operator=(const Gameboard& other);
+
+    /**
+     * Move operation
+     *
+     * As a copy, this board keeps its own observer
+     */
+    Gameboard& operator=(Gameboard&& other) noexcept;
+
+    /**
+     * Default destructor
+     */
+    ~Gameboard() noexcept = default;
+
     /**
      * Get a set of every possible movement for the character
      * \param usedForNotPossibleDisplay Used for display purpose only. If true, does not consider view and if there is character on the case
@@ -79,10 +137,15 @@ public:
     /**
      * Give all the actions a character can do
      * \param origin The position of the character to get its actions
-     * \return A vector with all the possible actions
+     * \param actions The list where the possible actions are added
+     */
+    void getPossibleActions(const gf::Vector2i& origin, MoveList& actions) const;
+
+    /**
+     * Give all the actions the playing team can do
+     * \param actions The list where the possible actions are added
      */
-    [[nodiscard]] std::vector<Action> getPossibleActions(const gf::Vector2i& origin) const;
-    [[nodiscard]] std::vector<Action> getPossibleActions() const;
+    void getPossibleActions(MoveList& actions) const;
 
     /**
      * Attack another character
@@ -165,7 +228,11 @@ public:
     [[nodiscard]] inline PlayerTeam getTeamFor(const gf::Vector2i& tile) const;
     [[nodiscard]] inline CharacterType getTypeFor(const gf::Vector2i& tile) const;
 
-    void display() const;
+    /**
+     * Write this board for humans, one line for each row of tiles
+     * \param out The stream to write to
+     */
+    void display(std::ostream& out) const;
 
     [[nodiscard]] constexpr PlayerTeam getPlayingTeam() const;
 
@@ -180,6 +247,20 @@ public:
     [[nodiscard]] inline bool isGoal(const gf::Vector2i& pos, PlayerTeam team) const;
 
     [[nodiscard]] int getNbOfActivatedGoals(PlayerTeam team) const;
+
+    /**
+     * Give the activated goals
+     * \return One bit for each goal, in the order of goalLayout
+     */
+    [[nodiscard]] std::uint8_t getActivatedGoals() const;
+
+    /**
+     * Put back the tiles and the goals as they were before an action
+     *
+     * Nothing is notified.
+     * \param record The record given by Action::executeReversibly
+     */
+    void restore(const UndoRecord& record);
     
     template<typename UnaryPositionFunc>
     constexpr void forEach(UnaryPositionFunc f) const;
@@ -188,15 +269,13 @@ public:
 
     [[nodiscard]] inline bool hasWon(PlayerTeam team) const;
 
-    template<typename BinaryFunc>
-    inline void setMoveCallback(BinaryFunc f);
-
-    template<typename BinaryFunc>
-    inline void setHPChangeCallback(BinaryFunc f);
-
-    [[nodiscard]] inline bool isCallbackNeeded() const;
-
-    inline void doFirstCallback();
+    /**
+     * Set what is notified when a character moves or is hurt
+     *
+     * The observer is not given to the copies of this board.
+     * \param observer The observer, or nullptr to notify nothing
+     */
+    inline void setObserver(BoardObserver* observer);
 
     [[nodiscard]] std::array<int, 2 * goalsPerTeam> getGoalsDistance(const gf::Vector2i& pos) const;
 
@@ -204,9 +283,24 @@ public:
 
     [[nodiscard]] BitsType computeBitRepresentation() const;
 
+    /**
+     * Give the Zobrist hash of this board
+     *
+     * It is kept up to date inside move, attack, useCapacity and switchTurn, so it costs nothing to get.
+     * \return The hash of the characters, the activated goals and the playing team
+     */
+    [[nodiscard]] constexpr std::uint64_t getHash() const;
+
 private:
     void tryGoalActivation(PlayerTeam team, const gf::Vector2i& position);
 
+    /**
+     * Give the Zobrist key of what stands on a tile
+     * \param tile The position of the tile
+     * \return The key of the character, or 0 if the tile is empty
+     */
+    [[nodiscard]] inline std::uint64_t getTileKey(const gf::Vector2i& tile) const;
+
     inline void swapPositions(const gf::Vector2i& origin, const gf::Vector2i& dest);
     inline void swapOccupiedPositions(const gf::Vector2i& origin, const gf::Vector2i& dest);
 
@@ -217,8 +311,21 @@ private:
     [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
         getAllPossibleCapacities(const gf::Vector2i& origin, const gf::Vector2i& executor) const;
 
+    /**
+     * Give the tiles where a character can do something
+     *
+     * Only the tiles listed in the precomputed tables are checked
+     *
+     * \param canDoSomething The function checking if the character can do the action on a tile
+     * \param getTargets The function giving the tiles the character may target, according to its type
+     * \param origin The position where the character will be while doing the action
+     * \param executor The position of the character
+     * \param usedForNotPossibleDisplay If true, also give the tiles where the action is unavailable
+     * \return The set of the targeted tiles
+     */
     [[nodiscard]] std::set<gf::Vector2i, PositionComp> getAllPossibleActionsOfAType(
             Ability (Gameboard::*canDoSomething)(const gf::Vector2i&, const gf::Vector2i&, const gf::Vector2i&) const,
+            const TargetList& (*getTargets)(CharacterType, int),
             const gf::Vector2i& origin,
             const gf::Vector2i& executor,
             bool usedForNotPossibleDisplay) const;
@@ -232,19 +339,23 @@ private:
      */
     inline void removeIfDead(const gf::Vector2i& target);
 
-    inline void pushLastMove(const gf::Vector2i& origin, const gf::Vector2i& dest);
-    inline void pushLastHPChange(const gf::Vector2i& pos, int hp);
+    inline void notifyMove(const gf::Vector2i& origin, const gf::Vector2i& dest);
+    inline void notifyHP(const gf::Vector2i& pos, int hp);
 
     gf::Array2D<std::optional<Character>> m_array;
     std::array<Goal, 2 * goalsPerTeam> m_goals;
     PlayerTeam m_playingTeam{PlayerTeam::Cthulhu};
+    std::uint64_t m_hash{0}; ///< The Zobrist hash of all of the above
 
-    std::function<void(const gf::Vector2i&, const gf::Vector2i&)> m_moveCallback = [](auto, auto) {};
-    std::function<void(const gf::Vector2i&, int)> m_hpChangeCallback = [](auto, auto) {};
-
-    std::queue<std::function<void()>> m_lastActions{};
+    BoardObserver* m_observer{nullptr}; ///< Neither copied nor moved
 };
 
+/**
+ * Write a board for humans
+ * \sa Gameboard::display
+ */
+inline std::ostream& operator<<(std::ostream& out, const Gameboard& board);
+
 #include "impl/gameboard.h"
 
 #endif //CTHULHUVSSATAN_GAMEBOARD_H
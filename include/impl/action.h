@@ -1,11 +1,10 @@
 #ifndef IMPL_ACTION_H
 #define IMPL_ACTION_H
 
+#include <gf/VectorOps.h>
+
 constexpr Action::Action(ActionType type, const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& target) :
-    m_type{type},
-    m_origin{origin},
-    m_dest{dest},
-    m_target{target}
+    Action{type, BoardMask::toSquare(origin), BoardMask::toSquare(dest), BoardMask::toSquare(target)}
 {
     // Nothing
 }
@@ -22,14 +21,125 @@ constexpr Action::Action(ActionType type, const gf::Vector2i& origin, const gf::
     // Nothing
 }
 
+constexpr Action::Action(ActionType type, int origin, int dest, int target) :
+    m_type{type},
+    m_origin{static_cast<std::int8_t>(origin)},
+    m_dest{static_cast<std::int8_t>(dest)},
+    m_target{static_cast<std::int8_t>(target)}
+{
+    // Nothing
+}
+
+template<typename Board>
+[[nodiscard]] bool Action::isValid(const Board& board) const
+{
+    const gf::Vector2i origin = getOrigin();
+    const gf::Vector2i dest = getDest();
+
+    if (!board.isOccupied(origin) || !board.canMove(origin, dest)) {
+        return false;
+    }
+
+    switch (m_type) {
+    case ActionType::Capacity:
+        return board.canUseCapacity(dest, getTarget(), origin);
+
+    case ActionType::Attack:
+        return board.canAttack(dest, getTarget(), origin);
+
+    case ActionType::None:
+        break;
+    }
+
+    return true;
+}
+
+template<typename Board>
+void Action::execute(Board& board) const
+{
+    const gf::Vector2i dest = getDest();
+
+    board.move(getOrigin(), dest);
+
+    switch (m_type) {
+    case ActionType::Capacity: {
+        board.useCapacity(dest, getTarget());
+    } break;
+
+    case ActionType::Attack: {
+        board.attack(dest, getTarget());
+    } break;
+
+    case ActionType::None:
+        break;
+    }
+}
+
+template<typename Board>
+[[nodiscard]] UndoRecord Action::executeReversibly(Board& board) const
+{
+    UndoRecord record{board.getActivatedGoals()};
+
+    auto keepTile{[&board, &record](const gf::Vector2i& pos) {
+        if (!BoardMask::isValid(pos)) {
+            return;
+        }
+
+        if (board.isOccupied(pos)) {
+            record.addTile(pos, board.getCharacter(pos));
+        } else {
+            record.addTile(pos, std::nullopt);
+        }
+    }};
+
+    const gf::Vector2i dest = getDest();
+    const gf::Vector2i target = getTarget();
+
+    keepTile(getOrigin());
+    if (m_dest != m_origin) {
+        keepTile(dest);
+    }
+
+    switch (m_type) {
+    case ActionType::Capacity: {
+        // A Tank pulls its target next to it, a Support pushes it one or two tiles away
+        // and a Scout swaps with it
+        gf::Vector2i dir = gf::sign(target - dest);
+        keepTile(target);
+        if (dest + dir != target) {
+            keepTile(dest + dir);
+        }
+        keepTile(target + dir);
+        keepTile(target + 2 * dir);
+    } break;
+
+    case ActionType::Attack: {
+        keepTile(target);
+    } break;
+
+    case ActionType::None:
+        break;
+    }
+
+    execute(board);
+
+    return record;
+}
+
+template<typename Board>
+void Action::undo(Board& board, const UndoRecord& record) const
+{
+    board.restore(record);
+}
+
 [[nodiscard]] constexpr gf::Vector2i Action::getDest() const
 {
-    return m_dest;
+    return BoardMask::toPosition(m_dest);
 }
 
 [[nodiscard]] constexpr gf::Vector2i Action::getTarget() const
 {
-    return m_target;
+    return BoardMask::toPosition(m_target);
 }
 
 [[nodiscard]] constexpr ActionType Action::getType() const
@@ -39,12 +149,59 @@ constexpr Action::Action(ActionType type, const gf::Vector2i& origin, const gf::
 
 [[nodiscard]] constexpr gf::Vector2i Action::getOrigin() const
 {
-    return m_origin;
+    return BoardMask::toPosition(m_origin);
 }
 
 [[nodiscard]] constexpr gf::Vector2i Action::getMove() const
 {
-    return m_dest - m_origin;
+    return getDest() - getOrigin();
+}
+
+[[nodiscard]] constexpr int Action::getOriginSquare() const
+{
+    return m_origin;
+}
+
+[[nodiscard]] constexpr int Action::getDestSquare() const
+{
+    return m_dest;
+}
+
+[[nodiscard]] constexpr int Action::getTargetSquare() const
+{
+    return m_target;
+}
+
+[[nodiscard]] constexpr std::uint32_t Action::pack() const
+{
+    return static_cast<std::uint32_t>(m_origin) |
+           static_cast<std::uint32_t>(m_dest) << squareBitCount |
+           static_cast<std::uint32_t>(m_target) << (2 * squareBitCount) |
+           static_cast<std::uint32_t>(m_type) << (3 * squareBitCount);
+}
+
+[[nodiscard]] constexpr Action Action::unpack(std::uint32_t bits)
+{
+    return Action{static_cast<ActionType>((bits >> (3 * squareBitCount)) & 0x3U),
+                  static_cast<int>(bits & squareMask),
+                  static_cast<int>((bits >> squareBitCount) & squareMask),
+                  static_cast<int>((bits >> (2 * squareBitCount)) & squareMask)};
+}
+
+constexpr bool Action::operator==(const Action& other) const
+{
+    return m_type == other.m_type && m_origin == other.m_origin && m_dest == other.m_dest && m_target == other.m_target;
+}
+
+constexpr bool Action::operator!=(const Action& other) const
+{
+    return !(*this == other);
+}
+
+inline std::ostream& operator<<(std::ostream& out, const Action& action)
+{
+    action.display(out);
+    return out;
 }
 
 #endif //IMPL_ACTION_H
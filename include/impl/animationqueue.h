@@ -0,0 +1,27 @@
+#ifndef IMPL_ANIMATIONQUEUE_H
+#define IMPL_ANIMATIONQUEUE_H
+
+template<typename BinaryFunc>
+inline void AnimationQueue::setMoveCallback(BinaryFunc f)
+{
+    m_moveCallback = f;
+}
+
+template<typename BinaryFunc>
+inline void AnimationQueue::setHPChangeCallback(BinaryFunc f)
+{
+    m_hpChangeCallback = f;
+}
+
+[[nodiscard]] inline bool AnimationQueue::isCallbackNeeded() const
+{
+    return !m_lastActions.empty();
+}
+
+inline void AnimationQueue::doFirstCallback()
+{
+    (m_lastActions.front())();
+    m_lastActions.pop();
+}
+
+#endif // IMPL_ANIMATIONQUEUE_H
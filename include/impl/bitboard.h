@@ -0,0 +1,161 @@
+#ifndef IMPL_BITBOARD_H
+#define IMPL_BITBOARD_H
+
+#include <gf/VectorOps.h>
+
+#include <cassert>
+
+[[nodiscard]] inline Ability Bitboard::canAttack(const gf::Vector2i& origin, const gf::Vector2i& dest) const
+{
+    return canAttack(origin, dest, origin);
+}
+
+[[nodiscard]] inline Ability Bitboard::canMove(const gf::Vector2i& origin, const gf::Vector2i& dest) const
+{
+    return canMove(origin, dest, origin);
+}
+
+[[nodiscard]] inline Ability Bitboard::canUseCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest) const
+{
+    return canUseCapacity(origin, dest, origin);
+}
+
+[[nodiscard]] inline bool Bitboard::capacityWillHurt(const gf::Vector2i& origin, const gf::Vector2i& dest) const
+{
+    assert(isOccupied(origin));
+    constexpr int ejectionDistance = 2;
+    return getTypeFor(origin) == CharacterType::Support && canUseCapacity(origin, dest) &&
+           !isTargetReachable(dest, dest + ejectionDistance * gf::sign(dest - origin));
+}
+
+[[nodiscard]] inline bool Bitboard::isEmpty(const gf::Vector2i& tile) const
+{
+    return BoardMask::isValid(tile) && !getOccupiedMask().test(BoardMask::toSquare(tile));
+}
+
+[[nodiscard]] inline bool Bitboard::isOccupied(const gf::Vector2i& tile) const
+{
+    return BoardMask::isValid(tile) && getOccupiedMask().test(BoardMask::toSquare(tile));
+}
+
+[[nodiscard]] inline Character Bitboard::getCharacter(const gf::Vector2i& tile) const
+{
+    Character character{getTeamFor(tile), getTypeFor(tile)};
+
+    int damage = character.getHPMax() - getHPFor(tile);
+    if (damage > 0) {
+        character.damage(damage);
+    }
+
+    return character;
+}
+
+[[nodiscard]] constexpr gf::Vector2i Bitboard::getSize() const
+{
+    return gf::Vector2i{BoardMask::width, BoardMask::height};
+}
+
+[[nodiscard]] inline PlayerTeam Bitboard::getTeamFor(const gf::Vector2i& tile) const
+{
+    assert(isOccupied(tile));
+    return m_teams[teamIndex(PlayerTeam::Cthulhu)].test(BoardMask::toSquare(tile)) ? PlayerTeam::Cthulhu : PlayerTeam::Satan;
+}
+
+[[nodiscard]] inline CharacterType Bitboard::getTypeFor(const gf::Vector2i& tile) const
+{
+    assert(isOccupied(tile));
+    int square = BoardMask::toSquare(tile);
+
+    if (m_types[typeIndex(CharacterType::Tank)].test(square)) {
+        return CharacterType::Tank;
+    }
+
+    if (m_types[typeIndex(CharacterType::Support)].test(square)) {
+        return CharacterType::Support;
+    }
+
+    return CharacterType::Scout;
+}
+
+[[nodiscard]] inline int Bitboard::getHPFor(const gf::Vector2i& tile) const
+{
+    assert(isOccupied(tile));
+    return m_hp[static_cast<std::size_t>(BoardMask::toSquare(tile))];
+}
+
+[[nodiscard]] inline BoardMask Bitboard::getTeamMask(PlayerTeam team) const
+{
+    return m_teams[teamIndex(team)];
+}
+
+[[nodiscard]] inline BoardMask Bitboard::getTypeMask(CharacterType type) const
+{
+    return m_types[typeIndex(type)];
+}
+
+[[nodiscard]] inline BoardMask Bitboard::getOccupiedMask() const
+{
+    return m_teams[0] | m_teams[1];
+}
+
+[[nodiscard]] constexpr PlayerTeam Bitboard::getPlayingTeam() const
+{
+    return m_playingTeam;
+}
+
+constexpr void Bitboard::switchTurn()
+{
+    m_hash ^= getPlayingTeamKey(PlayerTeam::Satan);
+    m_playingTeam = getEnemyTeam(m_playingTeam);
+}
+
+[[nodiscard]] inline bool Bitboard::isGoalActivated(std::size_t index) const
+{
+    assert(index < Gameboard::goalLayout.size());
+    return (m_activatedGoals & (1U << index)) != 0;
+}
+
+[[nodiscard]] inline std::uint8_t Bitboard::getActivatedGoals() const
+{
+    return m_activatedGoals;
+}
+
+[[nodiscard]] inline bool Bitboard::hasWon(PlayerTeam team) const
+{
+    return getNbOfActivatedGoals(team) == Gameboard::goalsPerTeam || getTeamMask(getEnemyTeam(team)).none();
+}
+
+[[nodiscard]] constexpr std::uint64_t Bitboard::getHash() const
+{
+    return m_hash;
+}
+
+[[nodiscard]] constexpr int Bitboard::getDamage(PlayerTeam team) const
+{
+    return m_damage[teamIndex(team)];
+}
+
+inline bool Bitboard::operator==(const Bitboard& other) const
+{
+    return std::tie(m_teams, m_types, m_hp, m_activatedGoals, m_playingTeam) ==
+           std::tie(other.m_teams, other.m_types, other.m_hp, other.m_activatedGoals, other.m_playingTeam);
+}
+
+[[nodiscard]] inline bool Bitboard::isTargetReachable(const gf::Vector2i& origin, const gf::Vector2i& dest, bool excludeDest) const
+{
+    assert(isOrthogonal(origin, dest) || isDiagonal(origin, dest));
+
+    if (!BoardMask::isValid(dest)) {
+        return false;
+    }
+
+    // The same as following the line from the origin, but all the tiles are checked at once
+    BoardMask path = BoardMask::between(origin, dest);
+    if (!excludeDest && origin != dest) {
+        path.set(BoardMask::toSquare(dest));
+    }
+
+    return (path & getOccupiedMask()).none();
+}
+
+#endif // IMPL_BITBOARD_H
@@ -0,0 +1,311 @@
+#ifndef IMPL_BOARDMASK_H
+#define IMPL_BOARDMASK_H
+
+#include <gf/VectorOps.h>
+
+#include <algorithm>
+#include <array>
+
+#include <cassert>
+
+namespace boardMaskBits {
+    constexpr int count(std::uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(bits);
+#else
+        int result = 0;
+        for (; bits != 0; bits &= bits - 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    constexpr int lowest(std::uint64_t bits)
+    {
+        assert(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int result = 0;
+        for (; (bits & 1U) == 0; bits >>= 1U) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    constexpr int highest(std::uint64_t bits)
+    {
+        assert(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(bits);
+#else
+        int result = 0;
+        for (; bits > 1; bits >>= 1U) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+} // namespace boardMaskBits
+
+constexpr BoardMask::BoardMask(std::uint64_t low, std::uint64_t high) :
+    m_low{low},
+    m_high{high & highWordMask}
+{
+    // Nothing
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::fromSquare(int square)
+{
+    assert(square >= 0 && square < squareCount);
+    return (square < lowBitCount) ? BoardMask{std::uint64_t{1} << square, 0} :
+                                    BoardMask{0, std::uint64_t{1} << (square - lowBitCount)};
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::full()
+{
+    return BoardMask{~std::uint64_t{0}, highWordMask};
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::column(int x)
+{
+    BoardMask result{};
+    for (int y = 0; y < height; ++y) {
+        result.set(y * width + x);
+    }
+    return result;
+}
+
+[[nodiscard]] constexpr bool BoardMask::isValid(const gf::Vector2i& pos)
+{
+    return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
+}
+
+[[nodiscard]] constexpr int BoardMask::toSquare(const gf::Vector2i& pos)
+{
+    assert(isValid(pos));
+    return pos.y * width + pos.x;
+}
+
+[[nodiscard]] constexpr gf::Vector2i BoardMask::toPosition(int square)
+{
+    assert(square >= 0 && square < squareCount);
+    return gf::Vector2i{square % width, square / width};
+}
+
+[[nodiscard]] constexpr bool BoardMask::test(int square) const
+{
+    return (*this & fromSquare(square)).any();
+}
+
+constexpr void BoardMask::set(int square)
+{
+    *this |= fromSquare(square);
+}
+
+constexpr void BoardMask::reset(int square)
+{
+    *this &= ~fromSquare(square);
+}
+
+[[nodiscard]] constexpr bool BoardMask::any() const
+{
+    return (m_low | m_high) != 0;
+}
+
+[[nodiscard]] constexpr bool BoardMask::none() const
+{
+    return !any();
+}
+
+[[nodiscard]] constexpr int BoardMask::count() const
+{
+    return boardMaskBits::count(m_low) + boardMaskBits::count(m_high);
+}
+
+[[nodiscard]] constexpr int BoardMask::first() const
+{
+    assert(any());
+    return (m_low != 0) ? boardMaskBits::lowest(m_low) : lowBitCount + boardMaskBits::lowest(m_high);
+}
+
+[[nodiscard]] constexpr int BoardMask::last() const
+{
+    assert(any());
+    return (m_high != 0) ? lowBitCount + boardMaskBits::highest(m_high) : boardMaskBits::highest(m_low);
+}
+
+constexpr int BoardMask::popFirst()
+{
+    int square = first();
+    if (m_low != 0) {
+        m_low &= m_low - 1;
+    } else {
+        m_high &= m_high - 1;
+    }
+    return square;
+}
+
+constexpr BoardMask BoardMask::operator~() const
+{
+    return BoardMask{~m_low, ~m_high};
+}
+
+constexpr BoardMask& BoardMask::operator&=(const BoardMask& other)
+{
+    m_low &= other.m_low;
+    m_high &= other.m_high;
+    return *this;
+}
+
+constexpr BoardMask& BoardMask::operator|=(const BoardMask& other)
+{
+    m_low |= other.m_low;
+    m_high |= other.m_high;
+    return *this;
+}
+
+constexpr BoardMask& BoardMask::operator^=(const BoardMask& other)
+{
+    m_low ^= other.m_low;
+    m_high ^= other.m_high;
+    return *this;
+}
+
+constexpr bool BoardMask::operator==(const BoardMask& other) const
+{
+    return m_low == other.m_low && m_high == other.m_high;
+}
+
+constexpr bool BoardMask::operator!=(const BoardMask& other) const
+{
+    return !(*this == other);
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::shiftedBits(int offset) const
+{
+    if (offset == 0) {
+        return *this;
+    }
+
+    if (offset >= squareCount || offset <= -squareCount) {
+        return BoardMask{};
+    }
+
+    if (offset > 0) {
+        auto n = static_cast<unsigned>(offset);
+        if (n >= lowBitCount) {
+            return BoardMask{0, m_low << (n - lowBitCount)};
+        }
+        return BoardMask{m_low << n, (m_high << n) | (m_low >> (lowBitCount - n))};
+    }
+
+    auto n = static_cast<unsigned>(-offset);
+    if (n >= lowBitCount) {
+        return BoardMask{m_high >> (n - lowBitCount), 0};
+    }
+    return BoardMask{(m_low >> n) | (m_high << (lowBitCount - n)), m_high >> n};
+}
+
+constexpr BoardMask operator&(BoardMask lhs, const BoardMask& rhs)
+{
+    return lhs &= rhs;
+}
+
+constexpr BoardMask operator|(BoardMask lhs, const BoardMask& rhs)
+{
+    return lhs |= rhs;
+}
+
+constexpr BoardMask operator^(BoardMask lhs, const BoardMask& rhs)
+{
+    return lhs ^= rhs;
+}
+
+namespace boardMaskBits {
+    /**
+     * The sets of the n first columns, for n from 0 to width
+     */
+    inline constexpr std::array<BoardMask, BoardMask::width + 1> leftColumns = [] {
+        std::array<BoardMask, BoardMask::width + 1> result{};
+        for (int n = 1; n <= BoardMask::width; ++n) {
+            result[n] = result[n - 1] | BoardMask::column(n - 1);
+        }
+        return result;
+    }();
+} // namespace boardMaskBits
+
+[[nodiscard]] constexpr BoardMask BoardMask::shifted(int dx, int dy) const
+{
+    BoardMask result = shiftedBits(dy * width + dx);
+
+    // Remove the tiles which have wrapped around to another row
+    if (dx > 0) {
+        result &= ~boardMaskBits::leftColumns[static_cast<std::size_t>(std::min(dx, width))];
+    } else if (dx < 0) {
+        result &= boardMaskBits::leftColumns[static_cast<std::size_t>(std::max(width + dx, 0))];
+    }
+
+    return result;
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::orthogonalNeighbours() const
+{
+    return shifted(1, 0) | shifted(-1, 0) | shifted(0, 1) | shifted(0, -1);
+}
+
+namespace boardMaskBits {
+    constexpr std::size_t directionCount = 9; ///< The 8 directions and the null one
+
+    constexpr std::size_t directionIndex(const gf::Vector2i& direction)
+    {
+        assert(direction.x >= -1 && direction.x <= 1 && direction.y >= -1 && direction.y <= 1);
+        return static_cast<std::size_t>((direction.y + 1) * 3 + direction.x + 1);
+    }
+
+    /**
+     * The rays from each tile to the edge of the board, in each direction
+     */
+    inline constexpr std::array<std::array<BoardMask, BoardMask::squareCount>, directionCount> rays = [] {
+        std::array<std::array<BoardMask, BoardMask::squareCount>, directionCount> result{};
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx == 0 && dy == 0) {
+                    continue;
+                }
+
+                auto& directionRays = result[directionIndex(gf::Vector2i{dx, dy})];
+                for (int square = 0; square < BoardMask::squareCount; ++square) {
+                    BoardMask tile = BoardMask::fromSquare(square);
+                    while ((tile = tile.shifted(dx, dy)).any()) {
+                        directionRays[static_cast<std::size_t>(square)] |= tile;
+                    }
+                }
+            }
+        }
+        return result;
+    }();
+} // namespace boardMaskBits
+
+[[nodiscard]] constexpr BoardMask BoardMask::ray(int square, const gf::Vector2i& direction)
+{
+    assert(square >= 0 && square < squareCount);
+    return boardMaskBits::rays[boardMaskBits::directionIndex(direction)][static_cast<std::size_t>(square)];
+}
+
+[[nodiscard]] constexpr BoardMask BoardMask::between(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    const gf::Vector2i relative = dest - origin;
+    if (relative.x != 0 && relative.y != 0 && relative.x != relative.y && relative.x != -relative.y) {
+        return BoardMask{};
+    }
+
+    // The ray from the origin towards the destination meets the ray from the destination backwards
+    const gf::Vector2i direction{(relative.x > 0) - (relative.x < 0), (relative.y > 0) - (relative.y < 0)};
+    return ray(toSquare(origin), direction) & ray(toSquare(dest), gf::Vector2i{-direction.x, -direction.y});
+}
+
+#endif // IMPL_BOARDMASK_H
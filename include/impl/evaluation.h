@@ -0,0 +1,16 @@
+#ifndef IMPL_EVALUATION_H
+#define IMPL_EVALUATION_H
+
+[[nodiscard]] constexpr std::array<std::pair<const char*, int EvalParams::*>, 6> EvalParams::getFields()
+{
+    return {{
+            {"damage", &EvalParams::damage},
+            {"threat", &EvalParams::threat},
+            {"hurtingCapacity", &EvalParams::hurtingCapacity},
+            {"activatedGoal", &EvalParams::activatedGoal},
+            {"deadCharacter", &EvalParams::deadCharacter},
+            {"goalProximity", &EvalParams::goalProximity},
+    }};
+}
+
+#endif // IMPL_EVALUATION_H
@@ -1,8 +1,15 @@
 #ifndef IMPL_GAMEAI_H
 #define IMPL_GAMEAI_H
 
-inline GameAI::GameAI(PlayerTeam team) :
-    Player{team}
+#include <algorithm>
+
+inline GameAI::GameAI(PlayerTeam team, const SearchSettings& settings) :
+    Player{team},
+    m_timeBudget{settings.timeBudget},
+    m_evalParams{settings.evalParams},
+    m_ponder{settings.ponder},
+    m_transpositionTable{settings.transpositionTableSize},
+    m_searchThreads(std::max(1U, (settings.threadCount > 0) ? settings.threadCount : std::thread::hardware_concurrency()))
 {
     // Nothing
 }
@@ -10,12 +17,40 @@ inline GameAI::GameAI(PlayerTeam team) :
 inline GameAI::~GameAI() noexcept
 {
     m_gameOpen = false;
+    m_threadInput.close();
     m_computingThread.join();
 }
 
+[[nodiscard]] constexpr bool GameAI::isWinScore(long score)
+{
+    return score >= minWinScore || score <= -minWinScore;
+}
+
+[[nodiscard]] constexpr long GameAI::scoreToTable(long score, int ply)
+{
+    if (score >= minWinScore) {
+        return score + ply;
+    }
+    if (score <= -minWinScore) {
+        return score - ply;
+    }
+    return score;
+}
+
+[[nodiscard]] constexpr long GameAI::scoreFromTable(long score, int ply)
+{
+    if (score >= minWinScore) {
+        return score - ply;
+    }
+    if (score <= -minWinScore) {
+        return score + ply;
+    }
+    return score;
+}
+
 inline void GameAI::askToPlay(const Gameboard& board)
 {
-    m_threadInput.push(board);
+    m_threadInput.push(Gameboard{board});
 }
 
 #endif //IMPL_GAMEAI_H
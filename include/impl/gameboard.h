@@ -29,19 +29,19 @@ constexpr Ability::operator Value() const
 [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
 Gameboard::getAllPossibleMoves(const gf::Vector2i& origin, bool usedForNotPossibleDisplay) const
 {
-    return getAllPossibleActionsOfAType(&Gameboard::canMove, origin, origin, usedForNotPossibleDisplay);
+    return getAllPossibleActionsOfAType(&Gameboard::canMove, &getMoveTargets, origin, origin, usedForNotPossibleDisplay);
 }
 
 [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
 Gameboard::getAllPossibleAttacks(const gf::Vector2i& origin, bool usedForNotPossibleDisplay) const
 {
-    return getAllPossibleActionsOfAType(&Gameboard::canAttack, origin, origin, usedForNotPossibleDisplay);
+    return getAllPossibleActionsOfAType(&Gameboard::canAttack, &getAttackTargets, origin, origin, usedForNotPossibleDisplay);
 }
 
 [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
 Gameboard::getAllPossibleCapacities(const gf::Vector2i& origin, bool usedForNotPossibleDisplay) const
 {
-    return getAllPossibleActionsOfAType(&Gameboard::canUseCapacity, origin, origin, usedForNotPossibleDisplay);
+    return getAllPossibleActionsOfAType(&Gameboard::canUseCapacity, &getCapacityTargets, origin, origin, usedForNotPossibleDisplay);
 }
 
 [[nodiscard]] inline Ability Gameboard::canAttack(const gf::Vector2i& origin, const gf::Vector2i& dest) const
@@ -107,6 +107,7 @@ Gameboard::getAllPossibleCapacities(const gf::Vector2i& origin, bool usedForNotP
 
 constexpr void Gameboard::switchTurn()
 {
+    m_hash ^= getPlayingTeamKey(PlayerTeam::Satan);
     m_playingTeam = getEnemyTeam(m_playingTeam);
 }
 
@@ -141,32 +142,24 @@ constexpr void Gameboard::forEach(UnaryPositionFunc f) const
     return getNbOfActivatedGoals(team) == goalsPerTeam || getTeamPositions(getEnemyTeam(team)).empty();
 }
 
-template<typename BinaryFunc>
-inline void Gameboard::setMoveCallback(BinaryFunc f)
+inline void Gameboard::setObserver(BoardObserver* observer)
 {
-    m_moveCallback = f;
+    m_observer = observer;
 }
 
-template<typename BinaryFunc>
-inline void Gameboard::setHPChangeCallback(BinaryFunc f)
+inline bool Gameboard::operator==(const Gameboard& other) const
 {
-    m_hpChangeCallback = f;
+    return std::tie(m_array, m_goals, m_playingTeam) == std::tie(other.m_array, other.m_goals, other.m_playingTeam);
 }
 
-[[nodiscard]] inline bool Gameboard::isCallbackNeeded() const
+[[nodiscard]] constexpr std::uint64_t Gameboard::getHash() const
 {
-    return !m_lastActions.empty();
+    return m_hash;
 }
 
-inline void Gameboard::doFirstCallback()
+[[nodiscard]] inline std::uint64_t Gameboard::getTileKey(const gf::Vector2i& tile) const
 {
-    (m_lastActions.front())();
-    m_lastActions.pop();
-}
-
-inline bool Gameboard::operator==(const Gameboard& other) const
-{
-    return std::tie(m_array, m_goals, m_playingTeam) == std::tie(other.m_array, other.m_goals, other.m_playingTeam);
+    return m_array(tile) ? getCharacterKey(BoardMask::toSquare(tile), *m_array(tile)) : 0;
 }
 
 inline void Gameboard::swapPositions(const gf::Vector2i& origin, const gf::Vector2i& dest)
@@ -174,7 +167,9 @@ inline void Gameboard::swapPositions(const gf::Vector2i& origin, const gf::Vecto
     assert(isOccupied(origin));
     assert(origin == dest || isEmpty(dest));
 
+    m_hash ^= getTileKey(origin) ^ getTileKey(dest);
     std::swap(m_array(origin), m_array(dest));
+    m_hash ^= getTileKey(origin) ^ getTileKey(dest);
     tryGoalActivation(m_array(dest)->getTeam(), dest);
 }
 
@@ -183,20 +178,22 @@ inline void Gameboard::swapOccupiedPositions(const gf::Vector2i& origin, const g
     assert(isOccupied(origin));
     assert(isOccupied(dest));
 
+    m_hash ^= getTileKey(origin) ^ getTileKey(dest);
     std::swap(m_array(origin), m_array(dest));
+    m_hash ^= getTileKey(origin) ^ getTileKey(dest);
     tryGoalActivation(m_array(dest)->getTeam(), dest);
 }
 
 [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
     Gameboard::getAllPossibleAttacks(const gf::Vector2i& origin, const gf::Vector2i& executor) const
 {
-    return getAllPossibleActionsOfAType(&Gameboard::canAttack, origin, executor, false);
+    return getAllPossibleActionsOfAType(&Gameboard::canAttack, &getAttackTargets, origin, executor, false);
 }
 
 [[nodiscard]] inline std::set<gf::Vector2i, PositionComp>
     Gameboard::getAllPossibleCapacities(const gf::Vector2i& origin, const gf::Vector2i& executor) const
 {
-    return getAllPossibleActionsOfAType(&Gameboard::canUseCapacity, origin, executor, false);
+    return getAllPossibleActionsOfAType(&Gameboard::canUseCapacity, &getCapacityTargets, origin, executor, false);
 }
 
 [[nodiscard]] inline bool Gameboard::isTargetReachable(const gf::Vector2i& origin, const gf::Vector2i& dest, bool excludeDest) const
@@ -210,20 +207,29 @@ inline void Gameboard::swapOccupiedPositions(const gf::Vector2i& origin, const g
 inline void Gameboard::removeIfDead(const gf::Vector2i& target)
 {
     if (isOccupied(target) && m_array(target)->isDead()) {
+        m_hash ^= getTileKey(target);
         m_array(target) = std::nullopt;
     }
 }
 
-inline void Gameboard::pushLastMove(const gf::Vector2i& origin, const gf::Vector2i& dest)
+inline void Gameboard::notifyMove(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    if (m_observer != nullptr && origin != dest) {
+        m_observer->notifyMove(origin, dest);
+    }
+}
+
+inline void Gameboard::notifyHP(const gf::Vector2i& pos, int hp)
 {
-    if (origin != dest) {
-        m_lastActions.emplace(std::bind(m_moveCallback, origin, dest));
+    if (m_observer != nullptr) {
+        m_observer->notifyHP(pos, hp);
     }
 }
 
-inline void Gameboard::pushLastHPChange(const gf::Vector2i& pos, int hp)
+inline std::ostream& operator<<(std::ostream& out, const Gameboard& board)
 {
-    m_lastActions.emplace(std::bind(m_hpChangeCallback, pos, hp));
+    board.display(out);
+    return out;
 }
 
 #endif //IMPL_GAMEBOARD_H
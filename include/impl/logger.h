@@ -0,0 +1,44 @@
+#ifndef IMPL_LOGGER_H
+#define IMPL_LOGGER_H
+
+#include <sstream>
+
+template<typename... Args>
+void Logger::debug(const Args&... args)
+{
+    if constexpr (isDebugCompiled) {
+        log(LogLevel::Debug, args...);
+    }
+}
+
+template<typename... Args>
+void Logger::info(const Args&... args)
+{
+    log(LogLevel::Info, args...);
+}
+
+template<typename... Args>
+void Logger::warning(const Args&... args)
+{
+    log(LogLevel::Warning, args...);
+}
+
+template<typename... Args>
+void Logger::error(const Args&... args)
+{
+    log(LogLevel::Error, args...);
+}
+
+template<typename... Args>
+void Logger::log(LogLevel level, const Args&... args)
+{
+    if (!isEnabled(level)) {
+        return;
+    }
+
+    std::ostringstream message{};
+    (message << ... << args);
+    push(level, message.str());
+}
+
+#endif //IMPL_LOGGER_H
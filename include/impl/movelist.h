@@ -0,0 +1,86 @@
+#ifndef IMPL_MOVELIST_H
+#define IMPL_MOVELIST_H
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include <cassert>
+
+template<typename... Args>
+inline void MoveList::emplace(Args&&... args)
+{
+    assert(m_size < capacity);
+    new (&m_storage[m_size]) Action{std::forward<Args>(args)...};
+    ++m_size;
+}
+
+inline void MoveList::push(const Action& action)
+{
+    emplace(action);
+}
+
+inline void MoveList::clear()
+{
+    m_size = 0;
+}
+
+template<typename Predicate>
+inline void MoveList::removeIf(Predicate predicate)
+{
+    m_size = static_cast<std::size_t>(std::remove_if(begin(), end(), predicate) - begin());
+}
+
+[[nodiscard]] inline bool MoveList::empty() const
+{
+    return m_size == 0;
+}
+
+[[nodiscard]] inline std::size_t MoveList::size() const
+{
+    return m_size;
+}
+
+[[nodiscard]] inline Action& MoveList::operator[](std::size_t index)
+{
+    assert(index < m_size);
+    return begin()[index];
+}
+
+[[nodiscard]] inline const Action& MoveList::operator[](std::size_t index) const
+{
+    assert(index < m_size);
+    return begin()[index];
+}
+
+[[nodiscard]] inline Action& MoveList::front()
+{
+    return (*this)[0];
+}
+
+[[nodiscard]] inline const Action& MoveList::front() const
+{
+    return (*this)[0];
+}
+
+[[nodiscard]] inline Action* MoveList::begin()
+{
+    return std::launder(reinterpret_cast<Action*>(m_storage.data()));
+}
+
+[[nodiscard]] inline Action* MoveList::end()
+{
+    return begin() + m_size;
+}
+
+[[nodiscard]] inline const Action* MoveList::begin() const
+{
+    return std::launder(reinterpret_cast<const Action*>(m_storage.data()));
+}
+
+[[nodiscard]] inline const Action* MoveList::end() const
+{
+    return begin() + m_size;
+}
+
+#endif // IMPL_MOVELIST_H
@@ -0,0 +1,18 @@
+#ifndef IMPL_MOVEORDERING_H
+#define IMPL_MOVEORDERING_H
+
+[[nodiscard]] inline int& MoveOrdering::getHistory(const Bitboard& board, const Action& action)
+{
+    return m_history[typeIndex(board.getTypeFor(action.getOrigin()))]
+                    [static_cast<std::size_t>(BoardMask::toSquare(action.getOrigin()))]
+                    [static_cast<std::size_t>(BoardMask::toSquare(action.getDest()))];
+}
+
+[[nodiscard]] inline int MoveOrdering::getHistory(const Bitboard& board, const Action& action) const
+{
+    return m_history[typeIndex(board.getTypeFor(action.getOrigin()))]
+                    [static_cast<std::size_t>(BoardMask::toSquare(action.getOrigin()))]
+                    [static_cast<std::size_t>(BoardMask::toSquare(action.getDest()))];
+}
+
+#endif // IMPL_MOVEORDERING_H
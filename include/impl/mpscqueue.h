@@ -0,0 +1,107 @@
+#ifndef IMPL_MPSCQUEUE_H
+#define IMPL_MPSCQUEUE_H
+
+#include <utility>
+
+template<typename T, std::size_t Capacity>
+MpscQueue<T, Capacity>::MpscQueue()
+{
+    for (std::size_t i = 0; i < Capacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] bool MpscQueue<T, Capacity>::tryPush(T&& value)
+{
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    while (true) {
+        slot = &m_slots[tail & (Capacity - 1)];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+        if (sequence == tail) {
+            // The slot is free for this turn, it is taken unless another producer has taken it first
+            if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < tail) {
+            // The slot still holds the value of the previous turn
+            return false;
+        } else {
+            tail = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->value.emplace(std::move(value));
+    slot->sequence.store(tail + 1, std::memory_order_release);
+
+    notifyConsumer();
+    return true;
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] std::optional<T> MpscQueue<T, Capacity>::tryPop()
+{
+    Slot& slot = m_slots[m_head & (Capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_head + 1) {
+        return std::nullopt;
+    }
+
+    std::optional<T> value{std::move(slot.value)};
+    slot.value.reset();
+    slot.sequence.store(m_head + Capacity, std::memory_order_release);
+    ++m_head;
+
+    return value;
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] std::optional<T> MpscQueue<T, Capacity>::waitPop()
+{
+    while (true) {
+        if (auto value = tryPop()) {
+            return value;
+        }
+
+        std::unique_lock<std::mutex> lock{m_wakeUpMutex};
+        m_consumerWaiting.store(true, std::memory_order_seq_cst);
+
+        // Checked again after telling the producers, so a value pushed meanwhile is not missed
+        if (empty()) {
+            if (m_closed.load(std::memory_order_seq_cst)) {
+                m_consumerWaiting.store(false, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            m_wakeUp.wait(lock);
+        }
+        m_consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, std::size_t Capacity>
+void MpscQueue<T, Capacity>::close()
+{
+    m_closed.store(true, std::memory_order_seq_cst);
+    notifyConsumer();
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] bool MpscQueue<T, Capacity>::empty() const
+{
+    return m_slots[m_head & (Capacity - 1)].sequence.load(std::memory_order_seq_cst) != m_head + 1;
+}
+
+template<typename T, std::size_t Capacity>
+void MpscQueue<T, Capacity>::notifyConsumer()
+{
+    // Orders the published value before reading the flag, as the consumer sets the flag before reading the slot
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_consumerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock{m_wakeUpMutex};
+        m_wakeUp.notify_one();
+    }
+}
+
+#endif //IMPL_MPSCQUEUE_H
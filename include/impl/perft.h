@@ -0,0 +1,66 @@
+#ifndef IMPL_PERFT_H
+#define IMPL_PERFT_H
+
+#include "utility.h"
+
+#include <cassert>
+
+template<typename Board>
+[[nodiscard]] std::uint64_t perft(Board& board, int depth)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    if (board.hasWon(PlayerTeam::Cthulhu) || board.hasWon(PlayerTeam::Satan)) {
+        return 0;
+    }
+
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    // The last actions are counted without being executed
+    if (depth == 1) {
+        return actions.size();
+    }
+
+    std::uint64_t count = 0;
+    for (const auto& action : actions) {
+        auto record = action.executeReversibly(board);
+        board.switchTurn();
+
+        count += perft(board, depth - 1);
+
+        board.switchTurn();
+        action.undo(board, record);
+    }
+
+    return count;
+}
+
+template<typename Board>
+[[nodiscard]] std::vector<std::pair<Action, std::uint64_t>> perftDivide(Board& board, int depth)
+{
+    assert(depth >= 1);
+
+    std::vector<std::pair<Action, std::uint64_t>> counts{};
+    if (board.hasWon(PlayerTeam::Cthulhu) || board.hasWon(PlayerTeam::Satan)) {
+        return counts;
+    }
+
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    for (const auto& action : actions) {
+        auto record = action.executeReversibly(board);
+        board.switchTurn();
+
+        counts.emplace_back(action, perft(board, depth - 1));
+
+        board.switchTurn();
+        action.undo(board, record);
+    }
+
+    return counts;
+}
+
+#endif // IMPL_PERFT_H
@@ -1,6 +1,8 @@
 #ifndef IMPL_POLLINGQUEUE_H
 #define IMPL_POLLINGQUEUE_H
 
+#include <cassert>
+
 template<typename T> template<typename U>
 void PollingQueue<T>::push(U&& value)
 {
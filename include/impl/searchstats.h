@@ -0,0 +1,61 @@
+#ifndef IMPL_SEARCHSTATS_H
+#define IMPL_SEARCHSTATS_H
+
+#include <algorithm>
+
+inline void SearchStats::countNode(int ply, bool isQuiescence)
+{
+    if constexpr (enabled) {
+        ++nodeCount;
+        if (isQuiescence) {
+            ++quiescenceNodeCount;
+        }
+        ++plyNodeCounts[std::min(static_cast<std::size_t>(ply), plyCount - 1)];
+    }
+}
+
+inline void SearchStats::countEvaluation()
+{
+    if constexpr (enabled) {
+        ++evaluationCount;
+    }
+}
+
+inline void SearchStats::countProbe(bool isHit)
+{
+    if constexpr (enabled) {
+        ++probeCount;
+        if (isHit) {
+            ++hitCount;
+        }
+    }
+}
+
+inline void SearchStats::countStore()
+{
+    if constexpr (enabled) {
+        ++storeCount;
+    }
+}
+
+inline void SearchStats::countCutoff(std::size_t actionIndex)
+{
+    if constexpr (enabled) {
+        ++cutoffCounts[std::min(actionIndex, cutoffIndexCount - 1)];
+    }
+}
+
+inline void SearchStats::addIteration(int depth, long score, std::uint64_t mainNodeCount, std::chrono::microseconds sinceStart)
+{
+    if constexpr (enabled) {
+        iterations.push_back(Iteration{depth, score, mainNodeCount, sinceStart});
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& out, const SearchStats& stats)
+{
+    stats.print(out);
+    return out;
+}
+
+#endif // IMPL_SEARCHSTATS_H
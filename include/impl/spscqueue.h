@@ -0,0 +1,99 @@
+#ifndef IMPL_SPSCQUEUE_H
+#define IMPL_SPSCQUEUE_H
+
+#include <thread>
+#include <utility>
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] bool SpscQueue<T, Capacity>::tryPush(T&& value)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead == Capacity) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead == Capacity) {
+            return false;
+        }
+    }
+
+    m_values[tail & (Capacity - 1)].emplace(std::move(value));
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    notifyConsumer();
+    return true;
+}
+
+template<typename T, std::size_t Capacity>
+void SpscQueue<T, Capacity>::push(T&& value)
+{
+    while (!tryPush(std::move(value))) {
+        std::this_thread::yield();
+    }
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] std::optional<T> SpscQueue<T, Capacity>::tryPop()
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cachedTail) {
+            return std::nullopt;
+        }
+    }
+
+    auto& slot = m_values[head & (Capacity - 1)];
+    std::optional<T> value{std::move(slot)};
+    slot.reset();
+    m_head.store(head + 1, std::memory_order_release);
+
+    return value;
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] std::optional<T> SpscQueue<T, Capacity>::waitPop()
+{
+    while (true) {
+        if (auto value = tryPop()) {
+            return value;
+        }
+
+        std::unique_lock<std::mutex> lock{m_wakeUpMutex};
+        m_consumerWaiting.store(true, std::memory_order_seq_cst);
+
+        // Checked again after telling the producer, so a value pushed meanwhile is not missed
+        if (empty()) {
+            if (m_closed.load(std::memory_order_seq_cst)) {
+                m_consumerWaiting.store(false, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            m_wakeUp.wait(lock);
+        }
+        m_consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, std::size_t Capacity>
+void SpscQueue<T, Capacity>::close()
+{
+    m_closed.store(true, std::memory_order_seq_cst);
+    notifyConsumer();
+}
+
+template<typename T, std::size_t Capacity>
+[[nodiscard]] bool SpscQueue<T, Capacity>::empty() const
+{
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_seq_cst);
+}
+
+template<typename T, std::size_t Capacity>
+void SpscQueue<T, Capacity>::notifyConsumer()
+{
+    // Orders the new tail before reading the flag, as the consumer sets the flag before reading the tail
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_consumerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock{m_wakeUpMutex};
+        m_wakeUp.notify_one();
+    }
+}
+
+#endif //IMPL_SPSCQUEUE_H
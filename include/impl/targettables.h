@@ -0,0 +1,158 @@
+#ifndef IMPL_TARGETTABLES_H
+#define IMPL_TARGETTABLES_H
+
+#include <cassert>
+
+[[nodiscard]] constexpr const std::int8_t* TargetList::begin() const
+{
+    return m_squares.data();
+}
+
+[[nodiscard]] constexpr const std::int8_t* TargetList::end() const
+{
+    return m_squares.data() + m_count;
+}
+
+[[nodiscard]] constexpr std::size_t TargetList::size() const
+{
+    return m_count;
+}
+
+constexpr void TargetList::push(int square)
+{
+    assert(m_count < capacity);
+    m_squares[m_count] = static_cast<std::int8_t>(square);
+    ++m_count;
+}
+
+namespace targetTables {
+    constexpr int absolute(int value)
+    {
+        return (value < 0) ? -value : value;
+    }
+
+    constexpr int manhattanLength(const gf::Vector2i& v)
+    {
+        return absolute(v.x) + absolute(v.y);
+    }
+
+    constexpr int chebyshevLength(const gf::Vector2i& v)
+    {
+        return (absolute(v.x) > absolute(v.y)) ? absolute(v.x) : absolute(v.y);
+    }
+
+    using Table = std::array<std::array<TargetList, BoardMask::squareCount>, 3>;
+
+    template<typename ShapePredicate>
+    constexpr Table makeTable(ShapePredicate isShape)
+    {
+        Table table{};
+        for (CharacterType type : {CharacterType::Tank, CharacterType::Support, CharacterType::Scout}) {
+            for (int origin = 0; origin < BoardMask::squareCount; ++origin) {
+                for (int dest = 0; dest < BoardMask::squareCount; ++dest) {
+                    gf::Vector2i relative{dest % BoardMask::width - origin % BoardMask::width,
+                                          dest / BoardMask::width - origin / BoardMask::width};
+                    if (isShape(type, relative)) {
+                        table[typeIndex(type)][static_cast<std::size_t>(origin)].push(dest);
+                    }
+                }
+            }
+        }
+        return table;
+    }
+} // namespace targetTables
+
+constexpr bool isMoveShape(CharacterType type, const gf::Vector2i& relative)
+{
+    if (relative.x == 0 && relative.y == 0) { // Don't move
+        return true;
+    }
+
+    switch (type) {
+    case CharacterType::Scout: {
+        constexpr int range = 2;
+        return (isOrthogonal(relative) || isDiagonal(relative)) && targetTables::chebyshevLength(relative) <= range;
+    }
+
+    case CharacterType::Tank: {
+        constexpr int sideRange = 2;
+        return targetTables::chebyshevLength(relative) == 1 || (relative.x == 0 && targetTables::absolute(relative.y) == sideRange);
+    }
+
+    case CharacterType::Support:
+        return targetTables::manhattanLength(relative) == 3 && relative.x != 0 && relative.y != 0;
+    }
+
+    return false;
+}
+
+constexpr bool isAttackShape(CharacterType type, const gf::Vector2i& relative)
+{
+    switch (type) {
+    case CharacterType::Scout:
+        return targetTables::manhattanLength(relative) <= 1;
+
+    case CharacterType::Support: {
+        constexpr int range = 3;
+        return isOrthogonal(relative) && targetTables::chebyshevLength(relative) <= range;
+    }
+
+    case CharacterType::Tank:
+        return targetTables::chebyshevLength(relative) == 1;
+    }
+
+    return false;
+}
+
+constexpr bool isCapacityShape(CharacterType type, const gf::Vector2i& relative)
+{
+    int manhattanDist = targetTables::manhattanLength(relative);
+    switch (type) {
+    case CharacterType::Scout:
+        return isDiagonal(relative) && (manhattanDist == 2 || manhattanDist == 4);
+
+    case CharacterType::Support:
+        return isOrthogonal(relative) && manhattanDist == 2;
+
+    case CharacterType::Tank:
+        return isOrthogonal(relative) && (manhattanDist == 2 || manhattanDist == 3);
+    }
+
+    return false;
+}
+
+namespace targetTables {
+    inline constexpr Table moves = makeTable(isMoveShape);
+    inline constexpr Table attacks = makeTable(isAttackShape);
+    inline constexpr Table capacities = makeTable(isCapacityShape);
+} // namespace targetTables
+
+[[nodiscard]] constexpr const TargetList& getMoveTargets(CharacterType type, int square)
+{
+    return targetTables::moves[typeIndex(type)][static_cast<std::size_t>(square)];
+}
+
+[[nodiscard]] constexpr const TargetList& getAttackTargets(CharacterType type, int square)
+{
+    return targetTables::attacks[typeIndex(type)][static_cast<std::size_t>(square)];
+}
+
+[[nodiscard]] constexpr const TargetList& getCapacityTargets(CharacterType type, int square)
+{
+    return targetTables::capacities[typeIndex(type)][static_cast<std::size_t>(square)];
+}
+
+[[nodiscard]] constexpr std::size_t getMaxActionCount(CharacterType type)
+{
+    auto maxSize = [&type](const targetTables::Table& table) {
+        std::size_t result = 0;
+        for (auto& targets : table[typeIndex(type)]) {
+            result = (targets.size() > result) ? targets.size() : result;
+        }
+        return result;
+    };
+
+    return maxSize(targetTables::moves) * (1 + maxSize(targetTables::attacks) + maxSize(targetTables::capacities));
+}
+
+#endif // IMPL_TARGETTABLES_H
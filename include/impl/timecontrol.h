@@ -0,0 +1,18 @@
+#ifndef IMPL_TIMECONTROL_H
+#define IMPL_TIMECONTROL_H
+
+inline TimeControl::TimeControl(std::chrono::milliseconds timeBudget, Clock::time_point start) :
+    m_isLimited{true},
+    m_start{start},
+    m_softTarget{timeBudget * softTargetPercent / 100},
+    m_hardCap{timeBudget}
+{
+    // Nothing
+}
+
+[[nodiscard]] constexpr bool TimeControl::isLimited() const
+{
+    return m_isLimited;
+}
+
+#endif // IMPL_TIMECONTROL_H
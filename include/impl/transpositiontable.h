@@ -0,0 +1,65 @@
+#ifndef IMPL_TRANSPOSITIONTABLE_H
+#define IMPL_TRANSPOSITIONTABLE_H
+
+[[nodiscard]] inline std::size_t TranspositionTable::getBucketCount() const
+{
+    return m_buckets.size();
+}
+
+[[nodiscard]] constexpr bool TranspositionTable::Data::isUsed() const
+{
+    return move != emptyMove;
+}
+
+[[nodiscard]] constexpr std::uint64_t TranspositionTable::Data::pack() const
+{
+    return static_cast<std::uint64_t>(move) |
+           static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << 32U |
+           static_cast<std::uint64_t>(depth) << 48U |
+           static_cast<std::uint64_t>(static_cast<std::uint8_t>(bound) | generation << boundBitCount) << 56U;
+}
+
+[[nodiscard]] constexpr TranspositionTable::Data TranspositionTable::Data::unpack(std::uint64_t bits)
+{
+    Data data{};
+    data.move = static_cast<std::uint32_t>(bits & 0xFFFFFFFFU);
+    data.score = static_cast<std::int16_t>((bits >> 32U) & 0xFFFFU);
+    data.depth = static_cast<std::uint8_t>((bits >> 48U) & 0xFFU);
+    data.bound = static_cast<Bound>((bits >> 56U) & ((1U << boundBitCount) - 1));
+    data.generation = static_cast<std::uint8_t>(bits >> (56U + boundBitCount));
+    return data;
+}
+
+[[nodiscard]] inline std::uint64_t TranspositionTable::Entry::getKey() const
+{
+    return keyXorData.load(std::memory_order_relaxed) ^ data.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] inline TranspositionTable::Data TranspositionTable::Entry::getData() const
+{
+    return Data::unpack(data.load(std::memory_order_relaxed));
+}
+
+inline void TranspositionTable::Entry::set(std::uint64_t key, const Data& newData)
+{
+    std::uint64_t bits = newData.pack();
+    keyXorData.store(key ^ bits, std::memory_order_relaxed);
+    data.store(bits, std::memory_order_relaxed);
+}
+
+inline void TranspositionTable::Entry::reset()
+{
+    set(0, Data{});
+}
+
+[[nodiscard]] inline TranspositionTable::Bucket& TranspositionTable::getBucket(std::uint64_t key)
+{
+    return m_buckets[static_cast<std::size_t>(key) & (m_buckets.size() - 1)];
+}
+
+[[nodiscard]] inline const TranspositionTable::Bucket& TranspositionTable::getBucket(std::uint64_t key) const
+{
+    return m_buckets[static_cast<std::size_t>(key) & (m_buckets.size() - 1)];
+}
+
+#endif // IMPL_TRANSPOSITIONTABLE_H
@@ -0,0 +1,65 @@
+#ifndef IMPL_UNDORECORD_H
+#define IMPL_UNDORECORD_H
+
+#include <cassert>
+
+constexpr UndoRecord::UndoRecord(std::uint8_t activatedGoals) :
+    m_activatedGoals{activatedGoals}
+{
+    // Nothing
+}
+
+constexpr void UndoRecord::addTile(const gf::Vector2i& pos, const std::optional<Character>& character)
+{
+    assert(m_tileCount < maxTiles);
+    m_squares[m_tileCount] = static_cast<std::int8_t>(BoardMask::toSquare(pos));
+    m_tiles[m_tileCount] = encode(character);
+    ++m_tileCount;
+}
+
+[[nodiscard]] constexpr std::uint8_t UndoRecord::getActivatedGoals() const
+{
+    return m_activatedGoals;
+}
+
+template<typename BinaryTileFunc>
+constexpr void UndoRecord::doWithTiles(BinaryTileFunc f) const
+{
+    for (std::size_t i = m_tileCount; i > 0; --i) {
+        f(BoardMask::toPosition(m_squares[i - 1]), decode(m_tiles[i - 1]));
+    }
+}
+
+[[nodiscard]] constexpr std::uint8_t UndoRecord::encode(const std::optional<Character>& character)
+{
+    if (!character) {
+        return 0;
+    }
+
+    // 1 bit to tell the tile is occupied, 1 for the team, 2 for the type and 4 for the HP
+    auto team = static_cast<unsigned>(teamIndex(character->getTeam()));
+    auto type = static_cast<unsigned>(typeIndex(character->getType()));
+
+    return static_cast<std::uint8_t>(1U | (team << 1U) | (type << 2U) | (static_cast<unsigned>(character->getHP()) << 4U));
+}
+
+[[nodiscard]] constexpr std::optional<Character> UndoRecord::decode(std::uint8_t tile)
+{
+    if (tile == 0) {
+        return std::nullopt;
+    }
+
+    constexpr CharacterType types[] = {CharacterType::Tank, CharacterType::Support, CharacterType::Scout};
+    PlayerTeam team = ((tile >> 1U) & 1U) ? PlayerTeam::Satan : PlayerTeam::Cthulhu;
+
+    Character character{team, types[(tile >> 2U) & 3U]};
+
+    int damage = character.getHPMax() - (tile >> 4U);
+    if (damage > 0) {
+        character.damage(damage);
+    }
+
+    return character;
+}
+
+#endif // IMPL_UNDORECORD_H
@@ -1,6 +1,25 @@
 #ifndef IMPL_UTILITY_H
 #define IMPL_UTILITY_H
 
+[[nodiscard]] constexpr std::size_t teamIndex(PlayerTeam team)
+{
+    return (team == PlayerTeam::Cthulhu) ? 0 : 1;
+}
+
+[[nodiscard]] constexpr std::size_t typeIndex(CharacterType type)
+{
+    switch (type) {
+    case CharacterType::Tank:
+        return 0;
+    case CharacterType::Support:
+        return 1;
+    case CharacterType::Scout:
+        return 2;
+    }
+
+    return 0; // to suppress the "no-return" warning
+}
+
 constexpr PlayerTeam getEnemyTeam(PlayerTeam team)
 {
     return (team == PlayerTeam::Cthulhu) ? PlayerTeam::Satan : PlayerTeam::Cthulhu;
@@ -0,0 +1,72 @@
+#ifndef IMPL_ZOBRIST_H
+#define IMPL_ZOBRIST_H
+
+#include <algorithm>
+
+#include <cassert>
+
+namespace zobrist {
+    constexpr int maxHP = std::max({Character::getHPMaxForType(CharacterType::Tank),
+                                    Character::getHPMaxForType(CharacterType::Support),
+                                    Character::getHPMaxForType(CharacterType::Scout)});
+
+    constexpr std::size_t characterKeyCount = BoardMask::squareCount * 2 * 3 * (maxHP + 1);
+    constexpr std::size_t goalKeyCount = 4;
+
+    /**
+     * The SplitMix64 generator, good enough to fill the tables at compile time
+     */
+    constexpr std::uint64_t splitMix(std::uint64_t& state)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31U);
+    }
+
+    template<std::size_t Count>
+    constexpr std::array<std::uint64_t, Count> makeKeys(std::uint64_t seed)
+    {
+        std::array<std::uint64_t, Count> keys{};
+        for (auto& key : keys) {
+            key = splitMix(seed);
+        }
+        return keys;
+    }
+
+    inline constexpr auto characterKeys = makeKeys<characterKeyCount>(0x7461637469636131ULL);
+    inline constexpr auto goalKeys = makeKeys<goalKeyCount>(0x7461637469636132ULL);
+    inline constexpr std::uint64_t satanKey = makeKeys<1>(0x7461637469636133ULL)[0];
+} // namespace zobrist
+
+[[nodiscard]] constexpr std::uint64_t getCharacterKey(int square, PlayerTeam team, CharacterType type, int hp)
+{
+    assert(square >= 0 && square < BoardMask::squareCount);
+    assert(hp <= zobrist::maxHP);
+
+    // A dead character is still on its tile until it is removed
+    std::size_t hpIndex = (hp > 0) ? static_cast<std::size_t>(hp) : 0;
+
+    return zobrist::characterKeys[((static_cast<std::size_t>(square) * 2 + teamIndex(team)) * 3 + typeIndex(type)) *
+                                          (zobrist::maxHP + 1) +
+                                  hpIndex];
+}
+
+[[nodiscard]] constexpr std::uint64_t getCharacterKey(int square, const Character& character)
+{
+    return getCharacterKey(square, character.getTeam(), character.getType(), character.getHP());
+}
+
+[[nodiscard]] constexpr std::uint64_t getGoalKey(std::size_t index)
+{
+    assert(index < zobrist::goalKeyCount);
+    return zobrist::goalKeys[index];
+}
+
+[[nodiscard]] constexpr std::uint64_t getPlayingTeamKey(PlayerTeam team)
+{
+    return (team == PlayerTeam::Satan) ? zobrist::satanKey : 0;
+}
+
+#endif // IMPL_ZOBRIST_H
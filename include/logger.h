@@ -0,0 +1,93 @@
+/**
+ * A file defining the log of the game and of its AI
+ */
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <string>
+
+/**
+ * How important a message is
+ */
+enum class LogLevel {
+    Debug, ///< What the AI does, to understand it
+    Info, ///< What happens in the game
+    Warning, ///< Something went wrong, the game goes on differently
+    Error, ///< Something went wrong, the game can not go on
+};
+
+/**
+ * The log of the game, written by a background thread
+ *
+ * The messages are written into a string by the thread logging them, then pushed
+ * without lock into a bounded queue, so logging never waits for the console, even in
+ * the search threads. A background thread writes them to the standard log output.
+ * If the queue is full, the message is dropped, which is told with the next message.
+ *
+ * The messages below the level of the log are not even written into a string, and
+ * the debug messages are removed by the compiler if NDEBUG is defined.
+ */
+class Logger {
+public:
+#ifdef NDEBUG
+    static constexpr bool isDebugCompiled = false;
+#else
+    static constexpr bool isDebugCompiled = true;
+#endif
+
+    /**
+     * Log a debug message
+     * \param args What the message is made of, written one after the other with operator<<
+     */
+    template<typename... Args>
+    static void debug(const Args&... args);
+
+    /**
+     * Log an information message
+     * \param args What the message is made of, written one after the other with operator<<
+     */
+    template<typename... Args>
+    static void info(const Args&... args);
+
+    /**
+     * Log a warning message
+     * \param args What the message is made of, written one after the other with operator<<
+     */
+    template<typename... Args>
+    static void warning(const Args&... args);
+
+    /**
+     * Log an error message
+     * \param args What the message is made of, written one after the other with operator<<
+     */
+    template<typename... Args>
+    static void error(const Args&... args);
+
+    /**
+     * Change the lowest level of the logged messages, Info by default
+     * \param level The level of the least important messages to log
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * Tell if the messages of a level are logged
+     * \param level The level of the messages
+     * \return True if they are logged
+     */
+    [[nodiscard]] static bool isEnabled(LogLevel level);
+
+private:
+    template<typename... Args>
+    static void log(LogLevel level, const Args&... args);
+
+    /**
+     * Give a message to the background thread
+     * \param level The level of the message
+     * \param message The text of the message
+     */
+    static void push(LogLevel level, std::string&& message);
+};
+
+#include "impl/logger.h"
+
+#endif // LOGGER_H
@@ -0,0 +1,75 @@
+/**
+ * A file providing a list of actions which does not allocate memory
+ */
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "action.h"
+#include "gameboard.h"
+#include "targettables.h"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+/**
+ * A list of actions stored in place
+ *
+ * Its capacity is enough to hold all the actions of a turn,
+ * so the generation of the actions never allocates memory.
+ *
+ * \sa Gameboard::getPossibleActions, Bitboard::getPossibleActions
+ */
+class MoveList {
+public:
+    /**
+     * The maximal number of actions a team can do during a turn
+     */
+    static constexpr std::size_t capacity = Gameboard::charactersPerTeam *
+                                            std::max({getMaxActionCount(CharacterType::Tank),
+                                                      getMaxActionCount(CharacterType::Support),
+                                                      getMaxActionCount(CharacterType::Scout)});
+
+    /**
+     * Add an action at the end of the list
+     * \param args The arguments of one of the constructors of Action
+     */
+    template<typename... Args>
+    inline void emplace(Args&&... args);
+
+    inline void push(const Action& action);
+
+    inline void clear();
+
+    /**
+     * Remove some actions, in place
+     * \param predicate Tells if an action is removed, the other ones keep their order
+     */
+    template<typename Predicate>
+    inline void removeIf(Predicate predicate);
+
+    [[nodiscard]] inline bool empty() const;
+    [[nodiscard]] inline std::size_t size() const;
+
+    [[nodiscard]] inline Action& operator[](std::size_t index);
+    [[nodiscard]] inline const Action& operator[](std::size_t index) const;
+
+    [[nodiscard]] inline Action& front();
+    [[nodiscard]] inline const Action& front() const;
+
+    [[nodiscard]] inline Action* begin();
+    [[nodiscard]] inline Action* end();
+    [[nodiscard]] inline const Action* begin() const;
+    [[nodiscard]] inline const Action* end() const;
+
+private:
+    static_assert(std::is_trivially_copyable_v<Action> && std::is_trivially_destructible_v<Action>,
+                  "The actions are copied and dropped without calling their constructors and destructors");
+
+    std::array<std::aligned_storage_t<sizeof(Action), alignof(Action)>, capacity> m_storage; ///< Not initialized
+    std::size_t m_size{0};
+};
+
+#include "impl/movelist.h"
+
+#endif // MOVELIST_H
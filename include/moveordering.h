@@ -0,0 +1,78 @@
+/**
+ * A file defining the order in which the AI searches the actions
+ */
+#ifndef MOVEORDERING_H
+#define MOVEORDERING_H
+
+#include "action.h"
+#include "bitboard.h"
+#include "boardmask.h"
+#include "movelist.h"
+
+#include <array>
+#include <optional>
+
+/**
+ * Sort the actions so the best ones are searched first
+ *
+ * The alpha-beta algorithm prunes much more when the best action is searched first.
+ * The actions are sorted by:
+ * 1. the best action given by the transposition table;
+ * 2. the attacks and the capacities of the Supports which hurt, the most dangerous
+ *    victims first, then the weakest;
+ * 3. the killer actions, which caused a cutoff at the same depth before;
+ * 4. the history of the cutoffs caused by the same character type moving between the same tiles.
+ */
+class MoveOrdering {
+public:
+    static constexpr int maxPly = 128; ///< The deepest ply with killer actions
+
+    /**
+     * Sort some actions, the most promising first
+     *
+     * \param board The board the actions are done on
+     * \param actions The actions to sort
+     * \param ply The distance from the root of the search
+     * \param bestAction The best action given by the transposition table, if any
+     */
+    void sort(const Bitboard& board, MoveList& actions, int ply, const std::optional<Action>& bestAction) const;
+
+    /**
+     * Remember an action which caused a cutoff
+     *
+     * \param board The board the action is done on, before it is done
+     * \param action The action
+     * \param ply The distance from the root of the search
+     * \param depth The remaining depth of the search
+     */
+    void addCutoff(const Bitboard& board, const Action& action, int ply, int depth);
+
+    /**
+     * Forget the killer actions and make the history less important, before a new search
+     */
+    void age();
+
+    /**
+     * Tell if an action hurts a character
+     * \param board The board the action is done on, before it is done
+     * \param action The action
+     * \return True for the attacks and the capacities of the Supports which hurt
+     */
+    [[nodiscard]] static bool isTactical(const Bitboard& board, const Action& action);
+
+private:
+    [[nodiscard]] int getScore(const Bitboard& board, const Action& action, int ply) const;
+
+    [[nodiscard]] inline int& getHistory(const Bitboard& board, const Action& action);
+    [[nodiscard]] inline int getHistory(const Bitboard& board, const Action& action) const;
+
+    using KillerSlots = std::array<std::optional<Action>, 2>;
+    using HistoryTable = std::array<std::array<std::array<int, BoardMask::squareCount>, BoardMask::squareCount>, 3>;
+
+    std::array<KillerSlots, maxPly> m_killers{};
+    HistoryTable m_history{}; ///< Indexed by the type of character, its origin and its destination
+};
+
+#include "impl/moveordering.h"
+
+#endif // MOVEORDERING_H
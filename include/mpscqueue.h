@@ -0,0 +1,110 @@
+/**
+ * A file defining a bounded queue from several threads to one, which does not lock
+ */
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include <cstddef>
+
+/**
+ * A bounded queue with several producer threads and a single consumer thread
+ *
+ * The values are stored in a ring buffer, where each slot has a sequence number
+ * telling if it is free or filled for the current turn of the buffer. The producers
+ * reserve a slot by incrementing the tail, then publish the value through the sequence
+ * number, so pushing and popping never lock. As in SpscQueue, only a consumer waiting
+ * for a value sleeps on a condition variable, notified when it is known to wait.
+ *
+ * \tparam T The type of the values, which are moved through the queue
+ * \tparam Capacity The maximal number of values in the queue, a power of two
+ * \sa SpscQueue
+ */
+template<typename T, std::size_t Capacity>
+class MpscQueue {
+public:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+
+    /**
+     * Constructor
+     */
+    MpscQueue();
+
+    /**
+     * Add a value at the end of the queue, if it is not full
+     *
+     * Any thread can call it.
+     *
+     * \param value The value to add, moved only if it is added
+     * \return True if the value has been added
+     */
+    [[nodiscard]] bool tryPush(T&& value);
+
+    /**
+     * Remove the first value of the queue, if any
+     *
+     * To be called by the consumer thread only.
+     *
+     * \return The first value, or nothing if the queue is empty
+     */
+    [[nodiscard]] std::optional<T> tryPop();
+
+    /**
+     * Remove the first value of the queue, waiting for it if the queue is empty
+     *
+     * To be called by the consumer thread only.
+     *
+     * \return The first value, or nothing if the queue is empty and closed
+     */
+    [[nodiscard]] std::optional<T> waitPop();
+
+    /**
+     * Wake up the consumer thread waiting for a value for good
+     *
+     * The values already in the queue can still be popped, but no value must be pushed after.
+     */
+    void close();
+
+    /**
+     * Tell if there is no value to pop
+     *
+     * To be called by the consumer thread only. A value being pushed is not counted yet.
+     */
+    [[nodiscard]] bool empty() const;
+
+private:
+    /**
+     * Wake up the consumer thread if it is waiting
+     */
+    void notifyConsumer();
+
+    static constexpr std::size_t cacheLineSize = 64;
+
+    /**
+     * A slot of the ring buffer
+     */
+    struct Slot {
+        std::atomic<std::size_t> sequence{0}; ///< The index it can be pushed at, or this index plus one once filled
+        std::optional<T> value{};
+    };
+
+    std::array<Slot, Capacity> m_slots{};
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_tail{0}; ///< The index after the last reserved slot, shared by the producers
+
+    alignas(cacheLineSize) std::size_t m_head{0}; ///< The index of the first value, only used by the consumer
+
+    alignas(cacheLineSize) std::atomic_bool m_closed{false};
+    std::atomic_bool m_consumerWaiting{false};
+    std::mutex m_wakeUpMutex{};
+    std::condition_variable m_wakeUp{};
+};
+
+#include "impl/mpscqueue.h"
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,47 @@
+/**
+ * A file counting the sequences of actions from a state of the game (perft)
+ *
+ * The counts only depend on the rules, so they check that the generation of the
+ * actions and the boards are still right when they are optimized, and the time
+ * they take measures how fast the actions are generated and executed.
+ */
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "action.h"
+#include "movelist.h"
+
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * Count the sequences of actions of a given length
+ *
+ * The actions are executed then undone on the board, which is the same at the end.
+ * A sequence stops when a team has won, so it is counted only if it is long enough.
+ *
+ * \param board The board to start from, a Gameboard or a Bitboard
+ * \param depth The number of actions of the sequences
+ * \return The number of sequences, which is the number of leaves of the tree of the game
+ */
+template<typename Board>
+[[nodiscard]] std::uint64_t perft(Board& board, int depth);
+
+/**
+ * Count the sequences of actions of a given length, for each first action
+ *
+ * It tells which action has a wrong count when two boards disagree.
+ *
+ * \param board The board to start from, a Gameboard or a Bitboard
+ * \param depth The number of actions of the sequences, at least 1
+ * \return Each action of the playing team, with the number of sequences starting with it
+ * \sa perft
+ */
+template<typename Board>
+[[nodiscard]] std::vector<std::pair<Action, std::uint64_t>> perftDivide(Board& board, int depth);
+
+#include "impl/perft.h"
+
+#endif // PERFT_H
@@ -0,0 +1,36 @@
+/**
+ * A file giving some states of the game, used to check and to measure the rules and the AI
+ */
+#ifndef REFERENCEPOSITIONS_H
+#define REFERENCEPOSITIONS_H
+
+#include "action.h"
+#include "gameboard.h"
+
+#include <array>
+#include <vector>
+
+/**
+ * A state of the game reached from the beginning of the game
+ *
+ * It is stored as the actions played to reach it, so it does not depend
+ * on the order in which the actions are generated.
+ */
+struct ReferencePosition {
+    const char* name;
+    std::vector<Action> actions; ///< The actions played from the beginning of the game
+
+    /**
+     * Play the actions from the beginning of the game
+     * \return The board of the state
+     */
+    [[nodiscard]] Gameboard makeBoard() const;
+};
+
+/**
+ * Give the stored states, from the beginning of the game to the end game
+ * \return The states, always in the same order
+ */
+[[nodiscard]] const std::array<ReferencePosition, 4>& getReferencePositions();
+
+#endif // REFERENCEPOSITIONS_H
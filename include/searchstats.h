@@ -0,0 +1,136 @@
+/**
+ * A file defining the statistics of the AI search
+ */
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include "moveordering.h"
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * What the AI search has done to find an action
+ *
+ * Each search thread counts in its own record, without synchronization, and the
+ * records are added together once the search is over.
+ *
+ * The counting is only done if the SEARCH_STATS macro is defined (see the SEARCH_STATS
+ * option of CMake). Otherwise the counting functions are empty and removed by the
+ * compiler, so the search costs the same as without statistics.
+ */
+struct SearchStats {
+#ifdef SEARCH_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    static constexpr std::size_t cutoffIndexCount = 8; ///< The cutoffs by the later actions are counted with the last index
+    static constexpr std::size_t plyCount = MoveOrdering::maxPly + 1; ///< The deeper nodes are counted with the last ply
+
+    /**
+     * An iteration of the main search thread, completed
+     */
+    struct Iteration {
+        int depth;
+        long score;
+        std::uint64_t nodeCount; ///< The number of nodes searched by the main thread since the search started
+        std::chrono::microseconds elapsed; ///< The time since the search started
+    };
+
+    /**
+     * Count a node of the search
+     * \param ply The distance from the root
+     * \param isQuiescence If the node is searched by the quiescence search
+     */
+    inline void countNode(int ply, bool isQuiescence);
+
+    /**
+     * Count an evaluation of a state
+     */
+    inline void countEvaluation();
+
+    /**
+     * Count a probe of the transposition table
+     * \param isHit If the position has been found
+     */
+    inline void countProbe(bool isHit);
+
+    /**
+     * Count a result stored in the transposition table
+     */
+    inline void countStore();
+
+    /**
+     * Count a beta cutoff of the alpha-beta search
+     * \param actionIndex The index of the action causing it, in the searched order
+     */
+    inline void countCutoff(std::size_t actionIndex);
+
+    /**
+     * Keep what a completed iteration has found
+     * \param depth The depth of the iteration
+     * \param score The score of the iteration
+     * \param mainNodeCount The number of nodes searched by the main thread since the search started
+     * \param sinceStart The time since the search started
+     */
+    inline void addIteration(int depth, long score, std::uint64_t mainNodeCount, std::chrono::microseconds sinceStart);
+
+    /**
+     * Add the counts of another thread
+     * \param other The statistics of the other thread, its iterations are not added
+     */
+    void merge(const SearchStats& other);
+
+    /**
+     * Give the mean number of children searched from a node
+     * \param ply The distance from the root of the nodes
+     * \return The number of nodes at the next ply for each node at this ply, 0 if there is none
+     */
+    [[nodiscard]] double getBranchingFactor(std::size_t ply) const;
+
+    /**
+     * Give how fast the search has been
+     * \return The number of nodes searched by second, by all the threads
+     */
+    [[nodiscard]] double getNodesPerSecond() const;
+
+    /**
+     * Write the statistics for humans
+     * \param out The stream to write to
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * Write the statistics as a JSON object, on a single line
+     * \param out The stream to write to
+     */
+    void writeJson(std::ostream& out) const;
+
+    std::uint64_t nodeCount{0}; ///< The number of nodes, including the quiescence nodes
+    std::uint64_t quiescenceNodeCount{0};
+    std::uint64_t evaluationCount{0}; ///< The number of evaluated states, at the leaves of the search
+    std::uint64_t probeCount{0};
+    std::uint64_t hitCount{0};
+    std::uint64_t storeCount{0};
+    std::array<std::uint64_t, cutoffIndexCount> cutoffCounts{}; ///< The number of beta cutoffs, by index of the action
+    std::array<std::uint64_t, plyCount> plyNodeCounts{}; ///< The number of nodes at each distance from the root
+    std::vector<Iteration> iterations{};
+    std::size_t threadCount{0};
+    std::chrono::microseconds elapsed{0}; ///< The time taken by the whole search
+};
+
+/**
+ * Write the statistics for humans
+ * \sa SearchStats::print
+ */
+inline std::ostream& operator<<(std::ostream& out, const SearchStats& stats);
+
+#include "impl/searchstats.h"
+
+#endif // SEARCHSTATS_H
@@ -0,0 +1,102 @@
+/**
+ * A file defining a bounded queue between two threads, which does not lock
+ */
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include <cstddef>
+
+/**
+ * A bounded queue with a single producer thread and a single consumer thread
+ *
+ * The values are stored in a ring buffer and the two threads only share the
+ * indices of its first and last values, so pushing and popping never lock.
+ * Only a consumer waiting for a value sleeps on a condition variable, which
+ * the producer notifies when it knows the consumer is waiting.
+ *
+ * \tparam T The type of the values, which are moved through the queue
+ * \tparam Capacity The maximal number of values in the queue, a power of two
+ */
+template<typename T, std::size_t Capacity>
+class SpscQueue {
+public:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+
+    /**
+     * Add a value at the end of the queue, if it is not full
+     *
+     * To be called by the producer thread only.
+     *
+     * \param value The value to add, moved only if it is added
+     * \return True if the value has been added
+     */
+    [[nodiscard]] bool tryPush(T&& value);
+
+    /**
+     * Add a value at the end of the queue, waiting while it is full
+     *
+     * To be called by the producer thread only.
+     *
+     * \param value The value to add
+     */
+    void push(T&& value);
+
+    /**
+     * Remove the first value of the queue, if any
+     *
+     * To be called by the consumer thread only.
+     *
+     * \return The first value, or nothing if the queue is empty
+     */
+    [[nodiscard]] std::optional<T> tryPop();
+
+    /**
+     * Remove the first value of the queue, waiting for it if the queue is empty
+     *
+     * To be called by the consumer thread only.
+     *
+     * \return The first value, or nothing if the queue is empty and closed
+     */
+    [[nodiscard]] std::optional<T> waitPop();
+
+    /**
+     * Wake up the consumer thread waiting for a value for good
+     *
+     * The values already in the queue can still be popped.
+     * To be called by the producer thread only.
+     */
+    void close();
+
+    [[nodiscard]] bool empty() const;
+
+private:
+    /**
+     * Wake up the consumer thread if it is waiting
+     */
+    void notifyConsumer();
+
+    static constexpr std::size_t cacheLineSize = 64;
+
+    std::array<std::optional<T>, Capacity> m_values{};
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_tail{0}; ///< The index after the last value, written by the producer
+    std::size_t m_cachedHead{0}; ///< The last head seen by the producer
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_head{0}; ///< The index of the first value, written by the consumer
+    std::size_t m_cachedTail{0}; ///< The last tail seen by the consumer
+
+    alignas(cacheLineSize) std::atomic_bool m_closed{false};
+    std::atomic_bool m_consumerWaiting{false};
+    std::mutex m_wakeUpMutex{};
+    std::condition_variable m_wakeUp{};
+};
+
+#include "impl/spscqueue.h"
+
+#endif // SPSCQUEUE_H
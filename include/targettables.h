@@ -0,0 +1,107 @@
+/**
+ * A file providing precomputed tables of the tiles each character can reach
+ */
+#ifndef TARGETTABLES_H
+#define TARGETTABLES_H
+
+#include "boardmask.h"
+#include "utility.h"
+
+#include <gf/Vector.h>
+
+#include <array>
+
+#include <cstdint>
+
+/**
+ * A short list of tiles
+ *
+ * It lists every tile a character could target from a given tile
+ * if the board was empty, i.e. every tile where it is not Ability::Unable.
+ */
+class TargetList {
+public:
+    static constexpr std::size_t capacity = 17; ///< The maximal number of targets, reached by a Scout moving
+
+    [[nodiscard]] constexpr const std::int8_t* begin() const;
+    [[nodiscard]] constexpr const std::int8_t* end() const;
+    [[nodiscard]] constexpr std::size_t size() const;
+
+    /**
+     * Add a tile at the end of the list
+     * \param square The index of the tile
+     */
+    constexpr void push(int square);
+
+private:
+    std::array<std::int8_t, capacity> m_squares{};
+    std::uint8_t m_count{0};
+};
+
+/**
+ * Tell if a character may move along a vector
+ *
+ * \param type The type of the character
+ * \param relative The movement
+ * \return False if Gameboard::canMove always answers Ability::Unable for this movement
+ */
+constexpr bool isMoveShape(CharacterType type, const gf::Vector2i& relative);
+
+/**
+ * Tell if a character may attack along a vector
+ *
+ * \param type The type of the character
+ * \param relative The vector between the attacker and the attacked tile
+ * \return False if Gameboard::canAttack always answers Ability::Unable for this vector
+ */
+constexpr bool isAttackShape(CharacterType type, const gf::Vector2i& relative);
+
+/**
+ * Tell if a character may use its capacity along a vector
+ *
+ * \param type The type of the character
+ * \param relative The vector between the character and the targeted tile
+ * \return False if Gameboard::canUseCapacity always answers Ability::Unable for this vector
+ */
+constexpr bool isCapacityShape(CharacterType type, const gf::Vector2i& relative);
+
+/**
+ * Give the tiles a character may move to, including its own tile
+ *
+ * \param type The type of the character
+ * \param square The index of the tile of the character
+ * \return The list of the tiles in the bounds of the board
+ */
+[[nodiscard]] constexpr const TargetList& getMoveTargets(CharacterType type, int square);
+
+/**
+ * Give the tiles a character may attack
+ *
+ * \param type The type of the character
+ * \param square The index of the tile the character attacks from
+ * \return The list of the tiles in the bounds of the board
+ */
+[[nodiscard]] constexpr const TargetList& getAttackTargets(CharacterType type, int square);
+
+/**
+ * Give the tiles a character may use its capacity on
+ *
+ * \param type The type of the character
+ * \param square The index of the tile the character uses its capacity from
+ * \return The list of the tiles in the bounds of the board
+ */
+[[nodiscard]] constexpr const TargetList& getCapacityTargets(CharacterType type, int square);
+
+/**
+ * Give the maximal number of actions a character can do from any tile,
+ * i.e. its maximal number of movements times its maximal number of attacks
+ * and capacity uses after each movement, plus the movement alone
+ *
+ * \param type The type of the character
+ * \return An upper bound of the number of actions of this character
+ */
+[[nodiscard]] constexpr std::size_t getMaxActionCount(CharacterType type);
+
+#include "impl/targettables.h"
+
+#endif // TARGETTABLES_H
@@ -0,0 +1,78 @@
+/**
+ * A file defining how long the AI searches an action
+ */
+#ifndef TIMECONTROL_H
+#define TIMECONTROL_H
+
+#include <chrono>
+
+#include <cstdint>
+
+/**
+ * The time given to the search of an action
+ *
+ * The search has two limits, from the time it starts:
+ * - a soft target, after which no new iteration is started, as it would most
+ *   likely not be completed; it is extended each time the best action changes
+ *   between two iterations, as the search is not sure of its choice yet;
+ * - a hard cap, the time budget, after which the search is aborted.
+ *
+ * The clock is only read every few nodes, counted by the searching thread.
+ */
+class TimeControl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::uint64_t nodesBetweenChecks = 1024; ///< The number of nodes searched between two clock checks
+
+    /**
+     * Constructor
+     *
+     * Give no time limit, the search is stopped by something else
+     */
+    TimeControl() = default;
+
+    /**
+     * Constructor
+     * \param timeBudget The time given to the search, the hard cap
+     * \param start When the search started
+     */
+    explicit inline TimeControl(std::chrono::milliseconds timeBudget, Clock::time_point start = Clock::now());
+
+    /**
+     * Tell that an iteration of the search is completed
+     * \param bestActionChanged If the iteration found another best action than the previous one
+     */
+    void completeIteration(bool bestActionChanged);
+
+    /**
+     * Tell if an iteration can be started
+     * \return True if the soft target is not passed yet
+     */
+    [[nodiscard]] bool canStartIteration() const;
+
+    /**
+     * Tell if the search must be aborted
+     *
+     * The clock is only checked when the node count is a multiple of nodesBetweenChecks.
+     *
+     * \param nodeCount The number of nodes the thread has searched
+     * \return True if the hard cap is passed
+     */
+    [[nodiscard]] bool isHardCapReached(std::uint64_t nodeCount) const;
+
+    [[nodiscard]] constexpr bool isLimited() const;
+
+private:
+    static constexpr int softTargetPercent = 40; ///< The first soft target, in percent of the time budget
+    static constexpr int extensionPercent = 30; ///< The extension of the soft target, in percent of the time budget
+
+    bool m_isLimited{false};
+    Clock::time_point m_start{};
+    Clock::duration m_softTarget{};
+    Clock::duration m_hardCap{};
+};
+
+#include "impl/timecontrol.h"
+
+#endif // TIMECONTROL_H
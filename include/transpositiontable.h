@@ -0,0 +1,170 @@
+/**
+ * A file defining the table keeping the results of the AI search
+ */
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include "action.h"
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * The kind of score kept in the table
+ */
+enum class Bound : std::uint8_t {
+    Exact, ///< The score is the exact value of the position
+    Lower, ///< The real value is at least the score (the search failed high)
+    Upper, ///< The real value is at most the score (the search failed low)
+};
+
+/**
+ * A hash table of the positions already searched, indexed by their Zobrist hash
+ *
+ * It has a fixed number of buckets, a power of two, and never allocates after its construction.
+ * Each bucket fills a cache line and holds some entries where the deepest results are kept,
+ * and one entry which is always replaced by the last result.
+ *
+ * Each entry remembers the search which has stored it (its generation), so the results of
+ * the previous searches give their place to the new ones, however deep they are.
+ *
+ * It can be probed and stored into by several threads at the same time, without lock.
+ * Two threads may overwrite each other's result, but a probe never gives a corrupted entry.
+ *
+ * \sa Gameboard::getHash, Bitboard::getHash
+ */
+class TranspositionTable {
+public:
+    /**
+     * What is known about a position
+     */
+    struct Result {
+        int depth; ///< The depth the position has been searched to
+        long score; ///< The score found by the search
+        Bound bound; ///< How the score relates to the real value
+        Action bestMove; ///< The best action found by the search
+    };
+
+    static constexpr std::size_t defaultSize = 16; ///< The default size, in MB
+
+    /**
+     * Constructor
+     *
+     * \param sizeInMB The maximal size of the table, in MB. The table is
+     * rounded down to a power of two of buckets.
+     */
+    explicit TranspositionTable(std::size_t sizeInMB = defaultSize);
+
+    /**
+     * Change the size of the table and forget everything
+     *
+     * It must not be called while other threads use the table.
+     * \param sizeInMB The maximal size of the table, in MB
+     */
+    void resize(std::size_t sizeInMB);
+
+    /**
+     * Forget everything
+     *
+     * It must not be called while other threads use the table.
+     */
+    void clear();
+
+    /**
+     * Look for a position
+     *
+     * When several entries hold the position, the one of the current search is chosen, then the deepest one.
+     * \param key The hash of the position
+     * \return What is known about the position, if it has been stored
+     */
+    [[nodiscard]] std::optional<Result> probe(std::uint64_t key) const;
+
+    /**
+     * Keep the result of a search
+     *
+     * \param key The hash of the position
+     * \param depth The depth of the search
+     * \param score The score found by the search, not stored if it does not fit in 16 bits
+     * \param bound How the score relates to the real value
+     * \param bestMove The best action found by the search
+     */
+    void store(std::uint64_t key, int depth, long score, Bound bound, const Action& bestMove);
+
+    /**
+     * Tell that a new search starts, so the results stored until now may be replaced
+     *
+     * They are still found by the probes until then.
+     * It must not be called while other threads use the table.
+     */
+    void newSearch();
+
+    [[nodiscard]] inline std::size_t getBucketCount() const;
+
+private:
+    static constexpr std::uint32_t emptyMove = 0xFFFFFFFF; ///< The move of an unused entry, which no packed action can be
+
+    static_assert(Action::packedBitCount < 32, "A packed action must not be mistaken for an unused entry");
+
+    static constexpr unsigned boundBitCount = 2; ///< The Bound takes the lowest bits of its byte, the generation the other ones
+    static constexpr std::uint8_t generationCount = 1U << (8 - boundBitCount);
+
+    /**
+     * What an entry keeps about a position, packed in 64 bits when stored
+     */
+    struct Data {
+        [[nodiscard]] constexpr bool isUsed() const;
+
+        [[nodiscard]] constexpr std::uint64_t pack() const;
+        [[nodiscard]] static constexpr Data unpack(std::uint64_t bits);
+
+        std::uint32_t move{emptyMove}; ///< The best move, packed by Action::pack
+        std::int16_t score{0};
+        std::uint8_t depth{0};
+        Bound bound{Bound::Exact};
+        std::uint8_t generation{0}; ///< The search which has stored the entry, modulo generationCount
+    };
+
+    /**
+     * An entry shared by all the search threads without lock
+     *
+     * The key is stored xored with the data, so an entry written by two threads
+     * at the same time matches none of the keys and is ignored.
+     */
+    struct Entry {
+        [[nodiscard]] inline std::uint64_t getKey() const;
+        [[nodiscard]] inline Data getData() const;
+        inline void set(std::uint64_t key, const Data& data);
+        inline void reset();
+
+        std::atomic<std::uint64_t> keyXorData{Data{}.pack()};
+        std::atomic<std::uint64_t> data{Data{}.pack()};
+    };
+
+    static_assert(sizeof(Entry) == 16, "An entry must stay small enough to fit 4 in a cache line");
+
+    static constexpr std::size_t cacheLineSize = 64;
+    static constexpr std::size_t depthPreferredCount = cacheLineSize / sizeof(Entry) - 1;
+
+    struct alignas(cacheLineSize) Bucket {
+        std::array<Entry, depthPreferredCount> depthPreferred{}; ///< Replaced by deeper searches
+        Entry alwaysReplace{}; ///< Replaced by every search
+    };
+
+    static_assert(sizeof(Bucket) == cacheLineSize, "A bucket must fill exactly a cache line");
+
+    [[nodiscard]] inline Bucket& getBucket(std::uint64_t key);
+    [[nodiscard]] inline const Bucket& getBucket(std::uint64_t key) const;
+
+    [[nodiscard]] static Result makeResult(const Data& data);
+
+    std::vector<Bucket> m_buckets;
+    std::uint8_t m_generation{0}; ///< The current search, modulo generationCount
+};
+
+#include "impl/transpositiontable.h"
+
+#endif // TRANSPOSITIONTABLE_H
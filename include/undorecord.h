@@ -0,0 +1,71 @@
+/**
+ * A file defining what is needed to cancel an action
+ */
+#ifndef UNDORECORD_H
+#define UNDORECORD_H
+
+#include "boardmask.h"
+#include "character.h"
+#include "utility.h"
+
+#include <gf/Vector.h>
+
+#include <array>
+#include <optional>
+
+#include <cstdint>
+
+/**
+ * The state of a board before an action
+ *
+ * Only the tiles the action may change are kept, with the characters
+ * standing on them (so the moved characters, the HP changes and the
+ * removed characters) and the activated goals.
+ *
+ * \sa Action::executeReversibly
+ */
+class UndoRecord {
+public:
+    /**
+     * The maximal number of tiles an action can change: the origin, the destination,
+     * the target and the tiles a character is pushed or pulled to
+     */
+    static constexpr std::size_t maxTiles = 6;
+
+    /**
+     * Constructor
+     *
+     * \param activatedGoals The goals activated before the action, one bit by goal
+     */
+    constexpr explicit UndoRecord(std::uint8_t activatedGoals);
+
+    /**
+     * Keep the state of a tile
+     *
+     * \param pos The position of the tile
+     * \param character The character on the tile, if any
+     */
+    constexpr void addTile(const gf::Vector2i& pos, const std::optional<Character>& character);
+
+    [[nodiscard]] constexpr std::uint8_t getActivatedGoals() const;
+
+    /**
+     * Do something with every kept tile, in the reverse order
+     * \param f A function taking the position of the tile and the character which was on it
+     */
+    template<typename BinaryTileFunc>
+    constexpr void doWithTiles(BinaryTileFunc f) const;
+
+private:
+    [[nodiscard]] static constexpr std::uint8_t encode(const std::optional<Character>& character);
+    [[nodiscard]] static constexpr std::optional<Character> decode(std::uint8_t tile);
+
+    std::array<std::int8_t, maxTiles> m_squares{}; ///< The indexes of the kept tiles
+    std::array<std::uint8_t, maxTiles> m_tiles{}; ///< The characters on the kept tiles, 0 if there was none
+    std::uint8_t m_tileCount{0};
+    std::uint8_t m_activatedGoals; ///< One bit for each goal of Gameboard::goalLayout
+};
+
+#include "impl/undorecord.h"
+
+#endif // UNDORECORD_H
@@ -13,6 +13,9 @@
 #include <optional>
 #include <tuple>
 
+#include <cstddef>
+#include <cstdint>
+
 /**
  * The different teams which fight in the game
  */
@@ -21,12 +24,20 @@ enum class PlayerTeam {
     Satan, ///< The Satan team
 };
 
+/**
+ * Get the index of a team in the arrays which have a value per team
+ *
+ * \param team The team
+ * \return 0 for Cthulhu, 1 for Satan
+ */
+[[nodiscard]] constexpr std::size_t teamIndex(PlayerTeam team);
+
 /**
  * The type of the action done by a character
  *
  * \sa Action
  */
-enum class ActionType {
+enum class ActionType : std::uint8_t {
     Attack, ///< The character attacks
     Capacity, ///< The character uses its capacity
     None, ///< The character does nothing, i.e. it just moves
@@ -43,6 +54,14 @@ enum class CharacterType {
     Scout, ///< The Scout, who is weak but fast
 };
 
+/**
+ * Get the index of a character type in the arrays which have a value per type
+ *
+ * \param type The type
+ * \return 0 for the Tank, 1 for the Support, 2 for the Scout
+ */
+[[nodiscard]] constexpr std::size_t typeIndex(CharacterType type);
+
 /**
  * Get the other team in the game
  *
@@ -0,0 +1,46 @@
+/**
+ * A file providing the random keys used to hash the boards
+ */
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "boardmask.h"
+#include "character.h"
+#include "utility.h"
+
+#include <array>
+
+#include <cstdint>
+
+/**
+ * Give the key of a character standing on a tile
+ *
+ * The hash of a board is the xor of the keys of its characters, of its activated goals
+ * and of its playing team, so it can be updated after each change instead of being computed again.
+ *
+ * \param square The index of the tile
+ * \param team The team of the character
+ * \param type The type of the character
+ * \param hp The HP of the character, at most the maximal HP of all the types
+ * \return A random key, different for every tile, team, type and HP
+ */
+[[nodiscard]] constexpr std::uint64_t getCharacterKey(int square, PlayerTeam team, CharacterType type, int hp);
+[[nodiscard]] constexpr std::uint64_t getCharacterKey(int square, const Character& character);
+
+/**
+ * Give the key of an activated goal
+ * \param index The index of the goal, in the order of Gameboard::goalLayout
+ * \return A random key
+ */
+[[nodiscard]] constexpr std::uint64_t getGoalKey(std::size_t index);
+
+/**
+ * Give the key of the playing team
+ * \param team The team which plays
+ * \return A random key for PlayerTeam::Satan, 0 for PlayerTeam::Cthulhu
+ */
+[[nodiscard]] constexpr std::uint64_t getPlayingTeamKey(PlayerTeam team);
+
+#include "impl/zobrist.h"
+
+#endif // ZOBRIST_H
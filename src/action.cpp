@@ -1,67 +1,31 @@
 #include "action.h"
 
-#include "gameboard.h"
+#include <ostream>
 
-#include <iostream>
-
-[[nodiscard]] bool Action::isValid(const Gameboard& board) const
-{
-    if (!board.isOccupied(m_origin) || !board.canMove(m_origin, m_dest)) {
-        return false;
-    }
-
-    switch (m_type) {
-    case ActionType::Capacity:
-        return board.canUseCapacity(m_dest, m_target, m_origin);
-
-    case ActionType::Attack:
-        return board.canAttack(m_dest, m_target, m_origin);
-
-    case ActionType::None:
-        break;
-    }
-
-    return true;
-}
-
-void Action::execute(Gameboard& board) const
+void Action::display(std::ostream& out) const
 {
-    board.move(m_origin, m_dest);
-
-    switch (m_type) {
-    case ActionType::Capacity: {
-        board.useCapacity(m_dest, m_target);
-    } break;
-
-    case ActionType::Attack: {
-        board.attack(m_dest, m_target);
-    } break;
+    const gf::Vector2i origin = getOrigin();
+    const gf::Vector2i dest = getDest();
+    const gf::Vector2i target = getTarget();
 
-    case ActionType::None:
-        break;
-    }
-}
-
-void Action::display() const
-{
-    if (m_origin != m_dest) {
-        std::cout << "Move from (" << m_origin.x << ", " << m_origin.y << ") to (" << m_dest.x << ", " << m_dest.y
+    if (origin != dest) {
+        out << "Move from (" << origin.x << ", " << origin.y << ") to (" << dest.x << ", " << dest.y
                   << ") then ";
     } else {
-        std::cout << "From (" << m_origin.x << ", " << m_origin.y << "), ";
+        out << "From (" << origin.x << ", " << origin.y << "), ";
     }
 
     switch (m_type) {
     case ActionType::Attack:
-        std::cout << "attack (" << m_target.x << ", " << m_target.y << ")" << std::endl;
+        out << "attack (" << target.x << ", " << target.y << ")";
         break;
 
     case ActionType::Capacity:
-        std::cout << "use capacity on (" << m_target.x << ", " << m_target.y << ")" << std::endl;
+        out << "use capacity on (" << target.x << ", " << target.y << ")";
         break;
 
     case ActionType::None:
-        std::cout << "do nothing" << std::endl;
+        out << "do nothing";
         break;
     }
 }
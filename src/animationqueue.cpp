@@ -0,0 +1,11 @@
+#include "animationqueue.h"
+
+void AnimationQueue::notifyMove(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    m_lastActions.emplace(std::bind(m_moveCallback, origin, dest));
+}
+
+void AnimationQueue::notifyHP(const gf::Vector2i& pos, int hp)
+{
+    m_lastActions.emplace(std::bind(m_hpChangeCallback, pos, hp));
+}
@@ -0,0 +1,617 @@
+#include "bitboard.h"
+
+#include "action.h"
+#include "movelist.h"
+#include "undorecord.h"
+
+#include <algorithm>
+
+namespace {
+/**
+ * The Manhattan distance from each goal to each tile
+ */
+constexpr auto goalDistances = [] {
+    std::array<std::array<std::int8_t, BoardMask::squareCount>, Gameboard::goalLayout.size()> distances{};
+    for (std::size_t goal = 0; goal < distances.size(); ++goal) {
+        gf::Vector2i goalPos = Gameboard::goalLayout[goal].getPosition();
+        for (int square = 0; square < BoardMask::squareCount; ++square) {
+            int dx = square % BoardMask::width - goalPos.x;
+            int dy = square / BoardMask::width - goalPos.y;
+            distances[goal][static_cast<std::size_t>(square)] = static_cast<std::int8_t>((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+        }
+    }
+    return distances;
+}();
+
+constexpr std::array<gf::Vector2i, 4> orthogonalDirections{gf::Vector2i{1, 0}, gf::Vector2i{-1, 0}, gf::Vector2i{0, 1}, gf::Vector2i{0, -1}};
+
+constexpr std::array<gf::Vector2i, 4> diagonalDirections{gf::Vector2i{1, 1}, gf::Vector2i{1, -1}, gf::Vector2i{-1, 1}, gf::Vector2i{-1, -1}};
+
+constexpr std::array<gf::Vector2i, 8> allDirections{gf::Vector2i{1, 0}, gf::Vector2i{-1, 0}, gf::Vector2i{0, 1}, gf::Vector2i{0, -1},
+                                                   gf::Vector2i{1, 1}, gf::Vector2i{1, -1}, gf::Vector2i{-1, 1}, gf::Vector2i{-1, -1}};
+
+constexpr std::array<gf::Vector2i, 8> supportMoves{gf::Vector2i{1, 2}, gf::Vector2i{1, -2}, gf::Vector2i{-1, 2}, gf::Vector2i{-1, -2},
+                                                  gf::Vector2i{2, 1}, gf::Vector2i{2, -1}, gf::Vector2i{-2, 1}, gf::Vector2i{-2, -1}};
+
+/**
+ * Follow a direction from some tiles, through the empty tiles
+ *
+ * \param from The starting tiles
+ * \param direction The direction to follow
+ * \param range The greatest distance from the starting tiles
+ * \param empty The tiles which do not stop the way
+ * \return The tiles reached, including the first tile which stops each way
+ */
+[[nodiscard]] BoardMask slide(BoardMask from, const gf::Vector2i& direction, int range, const BoardMask& empty)
+{
+    BoardMask reached{};
+    for (int distance = 1; distance <= range && from.any(); ++distance) {
+        from = from.shifted(direction.x, direction.y);
+        reached |= from;
+        from &= empty;
+    }
+    return reached;
+}
+} // namespace
+
+Bitboard::Bitboard() :
+    Bitboard{Gameboard{}}
+{
+    // Nothing
+}
+
+Bitboard::Bitboard(const Gameboard& board) :
+    m_playingTeam{board.getPlayingTeam()},
+    m_hash{getPlayingTeamKey(board.getPlayingTeam())}
+{
+    board.forEach([this, &board](auto pos) {
+        if (board.isOccupied(pos)) {
+            put(pos, board.getCharacter(pos));
+        }
+    });
+
+    std::size_t index = 0;
+    board.doWithGoals([this, &index](const Goal& goal) {
+        assert(goal == Gameboard::goalLayout[index] || goal.isActivated());
+        if (goal.isActivated()) {
+            m_activatedGoals |= 1U << index;
+            m_hash ^= getGoalKey(index);
+        }
+        ++index;
+    });
+}
+
+void Bitboard::getPossibleActions(const gf::Vector2i& origin, MoveList& actions) const
+{
+    // The targets are found from the board where the character has not moved yet, as canAttack and canUseCapacity do
+    CharacterType type = getTypeFor(origin);
+    BoardMask enemies = getTeamMask(getEnemyTeam(getTeamFor(origin)));
+
+    for (BoardMask moves = getMoveMask(origin); moves.any();) {
+        gf::Vector2i possibleMovement = BoardMask::toPosition(moves.popFirst());
+        actions.emplace(origin, possibleMovement);
+
+        for (BoardMask targets = getCapacityMask(type, possibleMovement); targets.any();) {
+            actions.emplace(ActionType::Capacity, origin, possibleMovement, BoardMask::toPosition(targets.popFirst()));
+        }
+
+        for (BoardMask targets = getAttackMask(type, possibleMovement) & enemies; targets.any();) {
+            actions.emplace(ActionType::Attack, origin, possibleMovement, BoardMask::toPosition(targets.popFirst()));
+        }
+    }
+}
+
+void Bitboard::getPossibleActions(MoveList& actions) const
+{
+    for (BoardMask characters = getTeamMask(m_playingTeam); characters.any();) {
+        getPossibleActions(BoardMask::toPosition(characters.popFirst()), actions);
+    }
+}
+
+bool Bitboard::attack(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    bool success = canAttack(origin, dest);
+
+    if (success) {
+        assert(isOccupied(origin));
+        assert(isOccupied(dest));
+        damage(dest, Character::getDamageForType(getTypeFor(origin)));
+    }
+
+    return success;
+}
+
+[[nodiscard]] Ability Bitboard::canAttack(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& executor) const
+{
+    assert(isOccupied(executor));
+
+    if (!BoardMask::isValid(dest)) {
+        return Ability::Unable;
+    }
+
+    Ability result = Ability::Unable;
+    gf::Vector2i relative = dest - origin;
+    switch (getTypeFor(executor)) {
+    case CharacterType::Scout: {
+        if (gf::manhattanDistance(origin, dest) <= 1) {
+            gf::Vector2i direction = gf::sign(relative);
+            assert(BoardMask::isValid(origin + direction));
+            result = (direction == relative || !isOccupied(origin + direction)) ? Ability::Able :
+                                                                                 Ability::Unavailable; // Can't attack through another character
+        }
+    } break;
+
+    case CharacterType::Support: {
+        constexpr int range = 3;
+
+        if (isOrthogonal(origin, dest) && gf::chebyshevLength(relative) <= range) {
+            result = isTargetReachable(origin, dest, true) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+
+    case CharacterType::Tank:
+        if (gf::chebyshevDistance(origin, dest) == 1) {
+            result = Ability::Able;
+        }
+    }
+
+    if (result) {
+        return (isOccupied(dest) && getTeamFor(dest) != getTeamFor(executor)) ? Ability::Able : Ability::Unavailable;
+    }
+
+    return result;
+}
+
+bool Bitboard::move(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    bool success{canMove(origin, dest)};
+
+    if (success) {
+        swapPositions(origin, dest);
+    }
+
+    return success;
+}
+
+[[nodiscard]] bool Bitboard::isLocked(const gf::Vector2i& pos) const
+{
+    if (!BoardMask::isValid(pos)) {
+        return false;
+    }
+
+    BoardMask enemyTanks = getTeamMask(getEnemyTeam(getTeamFor(pos))) & getTypeMask(CharacterType::Tank);
+    return (BoardMask::fromSquare(BoardMask::toSquare(pos)).orthogonalNeighbours() & enemyTanks).any();
+}
+
+bool Bitboard::useCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    if (!canUseCapacity(origin, dest)) {
+        return false;
+    }
+
+    switch (getTypeFor(origin)) {
+    case CharacterType::Scout: {
+        Character executor = getCharacter(origin);
+        Character target = getCharacter(dest);
+        remove(origin);
+        remove(dest);
+        put(origin, target);
+        put(dest, executor);
+        tryGoalActivation(executor.getTeam(), dest);
+    } break;
+
+    case CharacterType::Tank: {
+        gf::Vector2i newPos = origin + gf::sign(dest - origin);
+        swapPositions(dest, newPos);
+    } break;
+
+    case CharacterType::Support: {
+        constexpr int ejectionDistance = 2;
+        constexpr int ejectionDamage = 4;
+
+        gf::Vector2i ejectedPos = dest + ejectionDistance * gf::sign(dest - origin);
+        bool hurt = !isTargetReachable(dest, ejectedPos);
+
+        if (hurt) {
+            ejectedPos = getLastReachablePos(dest, ejectedPos);
+        }
+
+        swapPositions(dest, ejectedPos);
+
+        if (hurt) {
+            damage(ejectedPos, ejectionDamage);
+        }
+    } break;
+    }
+
+    return true;
+}
+
+[[nodiscard]] Ability Bitboard::canUseCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& executor) const
+{
+    assert(isOccupied(executor));
+
+    if (!BoardMask::isValid(dest)) {
+        return Ability::Unable;
+    }
+
+    int manhattanDist = gf::manhattanDistance(origin, dest);
+    switch (getTypeFor(executor)) {
+    case CharacterType::Scout: {
+        if (isDiagonal(origin, dest) && (manhattanDist == 2 || manhattanDist == 4)) {
+            return isOccupied(dest) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+
+    case CharacterType::Support: {
+        if (isOrthogonal(origin, dest) && manhattanDist == 2) {
+            return isOccupied(dest) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+
+    case CharacterType::Tank: {
+        if (isOrthogonal(origin, dest) && (manhattanDist == 2 || manhattanDist == 3)) {
+            return (isOccupied(dest) && isTargetReachable(origin, dest, true)) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+    }
+
+    return Ability::Unable;
+}
+
+[[nodiscard]] int Bitboard::getNbOfActivatedGoals(PlayerTeam team) const
+{
+    int result = 0;
+    for (std::size_t i = 0; i < Gameboard::goalLayout.size(); ++i) {
+        if (Gameboard::goalLayout[i].getTeam() == team && isGoalActivated(i)) {
+            ++result;
+        }
+    }
+
+    return result;
+}
+
+void Bitboard::restore(const UndoRecord& record)
+{
+    record.doWithTiles([this](const gf::Vector2i& pos, const std::optional<Character>& character) {
+        if (isOccupied(pos)) {
+            remove(pos);
+        }
+        if (character) {
+            put(pos, *character);
+        }
+    });
+
+    for (std::size_t i = 0; i < Gameboard::goalLayout.size(); ++i) {
+        if (((m_activatedGoals ^ record.getActivatedGoals()) & (1U << i)) != 0) {
+            m_hash ^= getGoalKey(i);
+        }
+    }
+    m_activatedGoals = record.getActivatedGoals();
+}
+
+[[nodiscard]] std::array<int, 2 * Gameboard::goalsPerTeam> Bitboard::getGoalsDistance(const gf::Vector2i& pos) const
+{
+    std::array<int, 2 * Gameboard::goalsPerTeam> ret{};
+    for (std::size_t i = 0; i < ret.size(); ++i) {
+        if (!isGoalActivated(i)) {
+            ret[i] = gf::manhattanDistance(pos, Gameboard::goalLayout[i].getPosition());
+        }
+    }
+    return ret;
+}
+
+[[nodiscard]] BoardMask Bitboard::getAttackedMask(PlayerTeam team) const
+{
+    constexpr int supportRange = 3; // As in canAttack
+
+    const BoardMask characters = getTeamMask(team);
+    const BoardMask empty = ~getOccupiedMask() & BoardMask::full();
+
+    const BoardMask scouts = characters & getTypeMask(CharacterType::Scout);
+    const BoardMask tanks = characters & getTypeMask(CharacterType::Tank);
+    const BoardMask supports = characters & getTypeMask(CharacterType::Support);
+
+    BoardMask attacked = scouts.orthogonalNeighbours();
+    for (const auto& direction : allDirections) {
+        attacked |= tanks.shifted(direction.x, direction.y);
+    }
+
+    // The attack of the Supports goes through the empty tiles up to the first character
+    for (const auto& direction : orthogonalDirections) {
+        BoardMask ray = supports;
+        for (int distance = 1; distance <= supportRange && ray.any(); ++distance) {
+            ray = ray.shifted(direction.x, direction.y);
+            attacked |= ray;
+            ray &= empty;
+        }
+    }
+
+    return attacked & getTeamMask(getEnemyTeam(team));
+}
+
+[[nodiscard]] BoardMask Bitboard::getCapacityHurtMask(PlayerTeam team) const
+{
+    constexpr int capacityRange = 2; // As in canUseCapacity
+
+    const BoardMask supports = getTeamMask(team) & getTypeMask(CharacterType::Support);
+    const BoardMask occupied = getOccupiedMask();
+    const BoardMask empty = ~occupied & BoardMask::full();
+
+    // The target is ejected two tiles further, and hurt if something, or the edge of the board, stops it
+    BoardMask hurt{};
+    for (const auto& direction : orthogonalDirections) {
+        BoardMask targets = supports.shifted(capacityRange * direction.x, capacityRange * direction.y) & occupied;
+        BoardMask freeEjections = empty.shifted(-direction.x, -direction.y) & empty.shifted(-2 * direction.x, -2 * direction.y);
+        hurt |= targets & ~freeEjections;
+    }
+
+    return hurt;
+}
+
+[[nodiscard]] int Bitboard::getGoalDistance(std::size_t index) const
+{
+    if (isGoalActivated(index)) {
+        return 0;
+    }
+
+    const BoardMask characters = getTeamMask(Gameboard::goalLayout[index].getTeam());
+    assert(characters.any());
+
+    int distance = BoardMask::width + BoardMask::height;
+    for (BoardMask remaining = characters; remaining.any();) {
+        distance = std::min(distance, static_cast<int>(goalDistances[index][static_cast<std::size_t>(remaining.popFirst())]));
+    }
+    return distance;
+}
+
+void Bitboard::put(const gf::Vector2i& tile, const Character& character)
+{
+    assert(isEmpty(tile));
+    int square = BoardMask::toSquare(tile);
+
+    m_teams[teamIndex(character.getTeam())].set(square);
+    m_types[typeIndex(character.getType())].set(square);
+    m_hp[static_cast<std::size_t>(square)] = static_cast<std::int8_t>(character.getHP());
+    m_hash ^= getCharacterKey(square, character);
+    m_damage[teamIndex(character.getTeam())] += character.getHPMax() - character.getHP();
+}
+
+void Bitboard::remove(const gf::Vector2i& tile)
+{
+    assert(isOccupied(tile));
+    int square = BoardMask::toSquare(tile);
+    m_hash ^= getCharacterKey(square, getTeamFor(tile), getTypeFor(tile), getHPFor(tile));
+    m_damage[teamIndex(getTeamFor(tile))] -= Character::getHPMaxForType(getTypeFor(tile)) - getHPFor(tile);
+
+    for (auto& team : m_teams) {
+        team.reset(square);
+    }
+    for (auto& type : m_types) {
+        type.reset(square);
+    }
+    m_hp[static_cast<std::size_t>(square)] = 0;
+}
+
+void Bitboard::tryGoalActivation(PlayerTeam team, const gf::Vector2i& position)
+{
+    for (std::size_t i = 0; i < Gameboard::goalLayout.size(); ++i) {
+        if (Gameboard::goalLayout[i].getPosition() == position && Gameboard::goalLayout[i].getTeam() == team &&
+            !isGoalActivated(i)) {
+            m_activatedGoals |= 1U << i;
+            m_hash ^= getGoalKey(i);
+        }
+    }
+}
+
+void Bitboard::swapPositions(const gf::Vector2i& origin, const gf::Vector2i& dest)
+{
+    assert(isOccupied(origin));
+    assert(origin == dest || isEmpty(dest));
+
+    PlayerTeam team = getTeamFor(origin);
+    if (origin != dest) {
+        Character character = getCharacter(origin);
+        remove(origin);
+        put(dest, character);
+    }
+    tryGoalActivation(team, dest);
+}
+
+[[nodiscard]] Ability Bitboard::canMove(const gf::Vector2i& origin, const gf::Vector2i& dest, const gf::Vector2i& /*executor*/) const
+{
+    assert(isOccupied(origin));
+
+    if (!BoardMask::isValid(dest)) {
+        return Ability::Unable;
+    }
+
+    if (origin == dest) { // Don't move
+        return Ability::Able;
+    }
+
+    gf::Vector2i relative = dest - origin;
+    Ability result = Ability::Unable;
+
+    switch (getTypeFor(origin)) {
+    case CharacterType::Scout: {
+        constexpr int range = 2;
+
+        if ((isOrthogonal(origin, dest) || isDiagonal(origin, dest)) && gf::chebyshevLength(relative) <= range) {
+            result = isTargetReachable(origin, dest) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+
+    case CharacterType::Tank: {
+        constexpr int sideRange = 2;
+
+        if (gf::chebyshevDistance(origin, dest) == 1 || (relative.x == 0 && std::abs(relative.y) == sideRange)) {
+            result = isTargetReachable(origin, dest) ? Ability::Able : Ability::Unavailable;
+        }
+    } break;
+
+    case CharacterType::Support: {
+        if (gf::manhattanDistance(origin, dest) == 3 && relative.x != 0 && relative.y != 0) {
+            result = Ability::Able;
+        }
+    } break;
+    }
+
+    if (result && (isOccupied(dest) || isLocked(origin))) {
+        result = Ability::Unavailable;
+    }
+
+    return result;
+}
+
+[[nodiscard]] BoardMask Bitboard::getMoveMask(const gf::Vector2i& origin) const
+{
+    assert(isOccupied(origin));
+
+    const BoardMask tile = BoardMask::fromSquare(BoardMask::toSquare(origin));
+    if (isLocked(origin)) {
+        return tile;
+    }
+
+    const BoardMask empty = ~getOccupiedMask() & BoardMask::full();
+    BoardMask moves{};
+
+    // As in canMove
+    switch (getTypeFor(origin)) {
+    case CharacterType::Scout: {
+        constexpr int range = 2;
+
+        for (const auto& direction : allDirections) {
+            moves |= slide(tile, direction, range, empty);
+        }
+    } break;
+
+    case CharacterType::Tank: {
+        constexpr int sideRange = 2;
+
+        for (const auto& direction : allDirections) {
+            moves |= tile.shifted(direction.x, direction.y);
+        }
+        moves |= slide(tile, gf::Vector2i{0, 1}, sideRange, empty) | slide(tile, gf::Vector2i{0, -1}, sideRange, empty);
+    } break;
+
+    case CharacterType::Support: {
+        for (const auto& move : supportMoves) {
+            moves |= tile.shifted(move.x, move.y);
+        }
+    } break;
+    }
+
+    return (moves & empty) | tile;
+}
+
+[[nodiscard]] BoardMask Bitboard::getAttackMask(CharacterType type, const gf::Vector2i& pos) const
+{
+    const BoardMask tile = BoardMask::fromSquare(BoardMask::toSquare(pos));
+
+    // As in canAttack
+    switch (type) {
+    case CharacterType::Scout:
+        return tile.orthogonalNeighbours();
+
+    case CharacterType::Support: {
+        constexpr int range = 3;
+
+        const BoardMask empty = ~getOccupiedMask() & BoardMask::full();
+        BoardMask attacks{};
+        for (const auto& direction : orthogonalDirections) {
+            attacks |= slide(tile, direction, range, empty);
+        }
+        return attacks;
+    }
+
+    case CharacterType::Tank: {
+        BoardMask attacks{};
+        for (const auto& direction : allDirections) {
+            attacks |= tile.shifted(direction.x, direction.y);
+        }
+        return attacks;
+    }
+    }
+
+    return BoardMask{};
+}
+
+[[nodiscard]] BoardMask Bitboard::getCapacityMask(CharacterType type, const gf::Vector2i& pos) const
+{
+    const BoardMask tile = BoardMask::fromSquare(BoardMask::toSquare(pos));
+    const BoardMask occupied = getOccupiedMask();
+    BoardMask targets{};
+
+    // As in canUseCapacity
+    switch (type) {
+    case CharacterType::Scout: {
+        for (const auto& direction : diagonalDirections) {
+            targets |= tile.shifted(direction.x, direction.y) | tile.shifted(2 * direction.x, 2 * direction.y);
+        }
+    } break;
+
+    case CharacterType::Support: {
+        constexpr int range = 2;
+
+        for (const auto& direction : orthogonalDirections) {
+            targets |= tile.shifted(range * direction.x, range * direction.y);
+        }
+    } break;
+
+    case CharacterType::Tank: {
+        constexpr int range = 3;
+
+        // The target is pulled, so it must not be next to the Tank already
+        const BoardMask empty = ~occupied & BoardMask::full();
+        for (const auto& direction : orthogonalDirections) {
+            targets |= slide(tile, direction, range, empty) & ~tile.shifted(direction.x, direction.y);
+        }
+    } break;
+    }
+
+    return targets & occupied;
+}
+
+[[nodiscard]] gf::Vector2i Bitboard::getLastReachablePos(const gf::Vector2i& origin,
+                                                         const gf::Vector2i& dest,
+                                                         bool excludeDest) const
+{
+    if ((!isOrthogonal(origin, dest) && !isDiagonal(origin, dest)) || origin == dest) {
+        return origin;
+    }
+
+    const gf::Vector2i direction = gf::sign(dest - origin);
+    const BoardMask ray = BoardMask::ray(BoardMask::toSquare(origin), direction);
+    const BoardMask blockers = ray & getOccupiedMask();
+
+    // The indices of the tiles increase along the ray if it goes right or down
+    const bool increasing = direction.y * BoardMask::width + direction.x > 0;
+
+    if (blockers.none()) {
+        // Nothing stops the character before the edge of the board
+        return ray.any() ? BoardMask::toPosition(increasing ? ray.last() : ray.first()) : origin;
+    }
+
+    const gf::Vector2i blocker = BoardMask::toPosition(increasing ? blockers.first() : blockers.last());
+    return excludeDest ? blocker : blocker - direction;
+}
+
+void Bitboard::damage(const gf::Vector2i& target, int amount)
+{
+    assert(isOccupied(target));
+    assert(amount > 0);
+
+    int square = BoardMask::toSquare(target);
+    auto& hp = m_hp[static_cast<std::size_t>(square)];
+    if (amount >= hp) {
+        remove(target);
+    } else {
+        PlayerTeam team = getTeamFor(target);
+        CharacterType type = getTypeFor(target);
+        m_hash ^= getCharacterKey(square, team, type, hp);
+        hp = static_cast<std::int8_t>(hp - amount);
+        m_hash ^= getCharacterKey(square, team, type, hp);
+        m_damage[teamIndex(team)] += amount;
+    }
+}
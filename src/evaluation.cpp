@@ -0,0 +1,87 @@
+#include "evaluation.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+constexpr int maxGoalDistance = BoardMask::width - 1 + BoardMask::height - 1; ///< The Manhattan distance between opposite corners
+} // namespace
+
+[[nodiscard]] bool EvalParams::loadFromFile(const std::string& path)
+{
+    std::ifstream file{path};
+    if (!file) {
+        return false;
+    }
+
+    constexpr auto fields = getFields();
+
+    // The weights are only changed if the whole file is right
+    EvalParams params{*this};
+
+    std::string line{};
+    while (std::getline(file, line)) {
+        std::istringstream stream{line};
+
+        std::string name{};
+        if (!(stream >> name) || name.front() == '#') {
+            continue;
+        }
+
+        auto field = std::find_if(fields.begin(), fields.end(), [&name](const auto& nameAndMember) {
+            return name == nameAndMember.first;
+        });
+
+        int value = 0;
+        if (field == fields.end() || !(stream >> value)) {
+            return false;
+        }
+        params.*(field->second) = value;
+    }
+
+    *this = params;
+    return true;
+}
+
+[[nodiscard]] bool EvalParams::saveToFile(const std::string& path) const
+{
+    std::ofstream file{path};
+    for (const auto& [name, member] : getFields()) {
+        file << name << ' ' << this->*member << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
+
+[[nodiscard]] long evaluate(const Bitboard& board, PlayerTeam team, const EvalParams& params)
+{
+    const PlayerTeam enemyTeam = getEnemyTeam(team);
+    const BoardMask myCharacters = board.getTeamMask(team);
+    const BoardMask otherCharacters = board.getTeamMask(enemyTeam);
+
+    long score = 0;
+
+    score += params.damage * board.getDamage(enemyTeam);
+
+    score += params.threat * board.getAttackedMask(team).count();
+    score -= params.threat * board.getAttackedMask(enemyTeam).count();
+
+    score += params.hurtingCapacity * (board.getCapacityHurtMask(team) & otherCharacters).count();
+    score -= params.hurtingCapacity * (board.getCapacityHurtMask(enemyTeam) & myCharacters).count();
+
+    score += params.activatedGoal * board.getNbOfActivatedGoals(team);
+    score -= params.activatedGoal * board.getNbOfActivatedGoals(enemyTeam);
+
+    score -= params.deadCharacter * (Gameboard::charactersPerTeam - myCharacters.count());
+    score += params.deadCharacter * (Gameboard::charactersPerTeam - otherCharacters.count());
+
+    if (myCharacters.any()) {
+        const std::size_t firstGoal = teamIndex(team) * Gameboard::goalsPerTeam;
+        for (std::size_t i = 0; i < Gameboard::goalsPerTeam; ++i) {
+            score += params.goalProximity * (maxGoalDistance - board.getGoalDistance(firstGoal + i));
+        }
+    }
+
+    return score;
+}
@@ -1,4 +1,5 @@
 #include "game.h"
+#include "logger.h"
 
 #include <gf/SpriteBatch.h>
 
@@ -11,8 +12,9 @@ Game::Game(gf::ResourceManager& resMgr) :
 
     m_gbView = std::make_unique<GameboardView>(m_board, *m_resMgr, m_entityMgr);
 
-    m_board.setMoveCallback(std::bind(&GameboardView::notifyMove, m_gbView.get(), _1, _2));
-    m_board.setHPChangeCallback(std::bind(&GameboardView::notifyHP, m_gbView.get(), _1, _2));
+    m_animations.setMoveCallback(std::bind(&GameboardView::notifyMove, m_gbView.get(), _1, _2));
+    m_animations.setHPChangeCallback(std::bind(&GameboardView::notifyHP, m_gbView.get(), _1, _2));
+    m_board.setObserver(&m_animations);
 
     initWindow();
     initViews();
@@ -21,6 +23,16 @@ Game::Game(gf::ResourceManager& resMgr) :
     initSprites();
 }
 
+[[nodiscard]] SearchSettings Game::loadSearchSettings(gf::ResourceManager& resMgr)
+{
+    SearchSettings settings{};
+    if (!settings.evalParams.loadFromFile(resMgr.search("ai/eval.txt").string())) {
+        Logger::warning("The weights of the AI can not be read, the default ones are used");
+    }
+
+    return settings;
+}
+
 void Game::processEvents()
 {
     gf::Event event{};
@@ -55,8 +67,8 @@ void Game::processEvents()
             break;
         }
 
-        if (m_board.isCallbackNeeded()) {
-            m_board.doFirstCallback();
+        if (m_animations.isCallbackNeeded()) {
+            m_animations.doFirstCallback();
             break;
         }
 
@@ -165,8 +177,8 @@ void Game::processEvents()
     } break;
 
     case GameState::GameEnd: {
-        if (m_board.isCallbackNeeded()) {
-            m_board.doFirstCallback();
+        if (m_animations.isCallbackNeeded()) {
+            m_animations.doFirstCallback();
             break;
         }
     } break;
@@ -1,374 +1,472 @@
 #include "gameai.h"
+#include "logger.h"
 
 #include <algorithm>
-#include <array>
-#include <bitset>
-#include <forward_list>
-#include <iostream>
-#include <queue>
 
 #include <cstdint>
 
-namespace {
-[[nodiscard]] std::uint64_t fnv1aHash(const Gameboard::BitsType& data)
+void GameAI::simulateActions()
 {
-    std::uint64_t hash = 14695981039346656037UL;
-
-    auto halfHash = [&hash](const std::uint64_t& halfData) {
-        for (std::size_t i = 0; i < 8; ++i) {
-            hash ^= (halfData & (0xFFUL << (i * 8UL))) >> (i * 8UL);
-            hash *= 1099511628211UL;
-        }
-    };
-
-    halfHash(data.first);
-    halfHash(data.second);
-
-    return hash;
-}
-
-class GameboardStateMap {
-public:
-    [[nodiscard]] const Action& operator[](const Gameboard& board) const;
+    Gameboard currentBoard{};
 
-    bool insert(const Gameboard& board, const Action& action, int turn);
+    while (m_gameOpen) {
+        const bool isOver = currentBoard.hasWon(PlayerTeam::Cthulhu) || currentBoard.hasWon(PlayerTeam::Satan);
 
-    [[nodiscard]] inline bool contains(const Gameboard& board) const;
+        // 1. Who is playing?
+        if (currentBoard.getPlayingTeam() == getTeam() && !isOver) {
+            // 1.a. Compute the action and send it
+            Action action = searchBestAction(currentBoard, TimeControl{m_timeBudget});
+            sendAction(currentBoard, action);
+            continue;
+        }
 
-private:
-    struct EntryType;
+        // 1.b.1. Search the answer to the predicted action of the enemy while it is thinking
+        std::optional<Gameboard> ponderBoard{};
+        std::optional<Action> ponderAction{};
+        const auto ponderStart = TimeControl::Clock::now();
 
-    [[nodiscard]] inline bool contains(const Gameboard::BitsType& board) const;
+        if (m_ponder && !isOver) {
+            Action prediction = predictEnemyAction(currentBoard);
 
-    [[nodiscard]] inline std::forward_list<EntryType>& getBucket(const Gameboard::BitsType& board);
-    [[nodiscard]] inline const std::forward_list<EntryType>& getBucket(const Gameboard::BitsType& board) const;
+            ponderBoard = currentBoard;
+            prediction.execute(*ponderBoard);
+            ponderBoard->switchTurn();
 
-    void removeOldEntries(int turn);
+            if (!ponderBoard->hasWon(PlayerTeam::Cthulhu) && !ponderBoard->hasWon(PlayerTeam::Satan)) {
+                ponderAction = searchBestAction(*ponderBoard, TimeControl{});
+            }
+        }
 
-    static constexpr std::size_t size = 256;
+        // 1.b.2. Sleep until the enemy has played
+        auto inputBoard = m_threadInput.waitPop();
+        if (!inputBoard) {
+            break;
+        }
+        currentBoard = std::move(*inputBoard);
 
-    std::size_t m_count{0};
-    std::array<std::forward_list<EntryType>, size> m_table{}; // TODO open addressing?
-};
+        // 1.b.3. If the prediction was right, the answer is sent once searched for as long as any action
+        if (ponderAction && currentBoard == *ponderBoard) {
+            const TimeControl timeControl{m_timeBudget, ponderStart};
+            if (timeControl.canStartIteration()) {
+                ponderAction = searchBestAction(currentBoard, timeControl);
+            }
 
-struct GameboardStateMap::EntryType {
-    Action action;
-    Gameboard::BitsType board;
-    int turn{0};
-};
+            Logger::debug("Prediction hit");
+            sendAction(currentBoard, *ponderAction);
+        }
+    }
+}
 
-[[nodiscard]] const Action& GameboardStateMap::operator[](const Gameboard& board) const
+void GameAI::sendAction(Gameboard& board, Action action)
 {
-    Gameboard::BitsType bitRepresentation = board.computeBitRepresentation();
-    auto& bucket = getBucket(bitRepresentation);
+    Logger::debug("Board:\n", board, "\nHash: ", board.getHash());
 
-    auto it = std::find_if(bucket.begin(), bucket.end(), [&bitRepresentation](auto& entry) {
-        return entry.board == bitRepresentation;
-    });
-    assert(it != bucket.end());
+    assert(action.isValid(board));
+    action.execute(board);
+    board.switchTurn();
 
-    return it->action;
-}
+    Logger::debug(action);
 
-bool GameboardStateMap::insert(const Gameboard& board, const Action& action, int turn)
-{
-    Gameboard::BitsType bitRepresentation = board.computeBitRepresentation();
+    if constexpr (SearchStats::enabled) {
+        Logger::info(m_searchStats);
 
-    if (contains(bitRepresentation)) {
-        return false;
+        std::lock_guard<std::mutex> lock{m_lastSearchStatsMutex};
+        m_lastSearchStats = m_searchStats;
     }
 
-    getBucket(bitRepresentation).push_front(EntryType{action, bitRepresentation, turn});
-    ++m_count;
+    m_threadOutput.push(std::move(action));
+}
 
-    if (10000 * m_count / size >= 5000) {
-        removeOldEntries(turn);
+Action GameAI::predictEnemyAction(const Gameboard& board)
+{
+    // The previous search has most likely found the best action of the enemy already
+    if (auto known = m_transpositionTable.probe(board.getHash()); known && known->bestMove.isValid(board)) {
+        return known->bestMove;
     }
 
-    return true;
+    return searchBestAction(board, TimeControl{m_timeBudget});
 }
 
-[[nodiscard]] inline bool GameboardStateMap::contains(const Gameboard& board) const
+void GameAI::tryToPlay(Gameboard& board)
 {
-    return contains(board.computeBitRepresentation());
+    if (auto action = m_threadOutput.tryPop()) {
+        assert(action->isValid(board));
+        action->execute(board);
+        board.switchTurn();
+    }
 }
 
-[[nodiscard]] inline bool GameboardStateMap::contains(const Gameboard::BitsType& board) const
+void GameAI::waitToPlay(Gameboard& board)
 {
-    auto& bucket = getBucket(board);
-
-    return std::any_of(bucket.begin(), bucket.end(), [&board](auto& entry) {
-        return entry.board == board;
-    });
+    if (auto action = m_threadOutput.waitPop()) {
+        assert(action->isValid(board));
+        action->execute(board);
+        board.switchTurn();
+    }
 }
 
-[[nodiscard]] inline std::forward_list<GameboardStateMap::EntryType>& GameboardStateMap::getBucket(const Gameboard::BitsType& board)
+SearchStats GameAI::getLastSearchStats() const
 {
-    std::uint64_t hash = fnv1aHash(board);
-    return m_table[static_cast<std::size_t>(hash % size)];
+    std::lock_guard<std::mutex> lock{m_lastSearchStatsMutex};
+    return m_lastSearchStats;
 }
 
-[[nodiscard]] inline const std::forward_list<GameboardStateMap::EntryType>& GameboardStateMap::getBucket(const Gameboard::BitsType& board) const
+long GameAI::functionEval(const Bitboard& board)
 {
-    std::uint64_t hash = fnv1aHash(board);
-    return m_table[static_cast<std::size_t>(hash % size)];
-}
+    //check if one player has nearly lost
+    if (board.getTeamMask(getTeam()).count() == 1) {
+        return -maxEvalScore;
+    }
 
-void GameboardStateMap::removeOldEntries(int turn)
-{
-    std::cout << "Cleaning hash map..." << std::endl;
-    for (auto& bucket : m_table) {
-        bucket.remove_if([&turn](auto& entry) {
-            return turn - entry.turn >= 5;
-        });
+    if (board.getTeamMask(getEnemyTeam(getTeam())).count() == 1) {
+        return maxEvalScore;
     }
+
+    // The tuned weights must not give the score of a won game, nor a score too big for the transposition table
+    return std::clamp(evaluate(board, getTeam(), m_evalParams), -maxEvalScore, maxEvalScore);
 }
-} // namespace
 
-void GameAI::simulateActions()
+long GameAI::evaluateForPlayingTeam(const Bitboard& board)
 {
-    Gameboard currentBoard{};
-    std::queue<Action> nextActions{};
+    long score = functionEval(board);
+    return (board.getPlayingTeam() == getTeam()) ? score : -score;
+}
 
-    int currentTurn = 0;
-    GameboardStateMap actionMap{};
+Action GameAI::searchBestAction(const Gameboard& board, const TimeControl& timeControl)
+{
+    const Bitboard searchBoard{board};
+
+    m_timeControl = timeControl;
+    m_searchStart = TimeControl::Clock::now();
+    m_stopSearch = false;
+    m_transpositionTable.newSearch();
+
+    for (auto& thread : m_searchThreads) {
+        thread.moveOrdering.age();
+        thread.nodeCount = 0;
+        thread.completedDepth = 0;
+        thread.bestAction.reset();
+        thread.stats = SearchStats{};
+    }
 
-    while (m_gameOpen) {
-        // 1. Who is playing?
-        if (currentBoard.getPlayingTeam() == getTeam()) {
-            // 1.a. If an action is computed, send it
-            if (!nextActions.empty()) {
-                auto action = nextActions.front();
+    std::vector<std::thread> helpers{};
+    helpers.reserve(m_searchThreads.size() - 1);
+    for (std::size_t i = 1; i < m_searchThreads.size(); ++i) {
+        helpers.emplace_back(&GameAI::iterativeDeepening, this, std::ref(m_searchThreads[i]), i, std::cref(searchBoard));
+    }
 
-                assert(action.isValid(currentBoard));
-                action.execute(currentBoard);
-                currentBoard.switchTurn();
+    iterativeDeepening(m_searchThreads.front(), 0, searchBoard);
 
-                action.display();
-                m_threadOutput.push(std::move(action));
-                nextActions.pop();
+    m_stopSearch = true;
+    for (auto& helper : helpers) {
+        helper.join();
+    }
 
-                ++currentTurn;
-            }
-        } else if (!m_threadInput.empty()) {
-            // 1.b.1. Do the action
-            auto inputBoard = m_threadInput.poll();
-
-            // 1.b.2. Check the prediction if any
-            if (!nextActions.empty()) {
-                auto action = nextActions.front();
-
-                action.execute(currentBoard);
-                currentBoard.switchTurn();
-
-                if (inputBoard == currentBoard) {
-                    nextActions.pop();
-                } else {
-                    nextActions = std::queue<Action>{};
-                    currentBoard = std::move(inputBoard);
-                }
-            }
+    // The deepest completed iteration gives the action, the main thread's one if several are as deep
+    const SearchThread* best = &m_searchThreads.front();
+    for (const auto& thread : m_searchThreads) {
+        if (thread.completedDepth > best->completedDepth) {
+            best = &thread;
         }
+    }
 
-        // 2. Compute action
-        if (nextActions.empty()) {
-            Action action = [this, &actionMap, &currentBoard, &currentTurn] {
-                if (actionMap.contains(currentBoard)) {
-                    return actionMap[currentBoard];
-                }
-
-                depthActionsExploration actionToDo = bestActionInFuture(currentBoard,
-                                                                        0); // TODO in depths, save states in map
-                actionMap.insert(currentBoard, actionToDo.first, currentTurn);
-                return actionToDo.first;
-            }();
-
-//            nextActions.push(currentBoard.getPossibleActions()[0]);
-            nextActions.push(action);
-
-            currentBoard.display();
-            Gameboard::BitsType bitRepresentation = currentBoard.computeBitRepresentation();
-            std::cout << "Bits: " << ((std::bitset<128>{bitRepresentation.first} << 64) |
-                                      std::bitset<128>{bitRepresentation.second}).to_string()
-                      << "\n";
-            auto hash = fnv1aHash(bitRepresentation);
-            std::cout << "Hash: " << hash << " (" << (hash & 0xFFUL) << ")" << std::endl;
+    if constexpr (SearchStats::enabled) {
+        m_searchStats = SearchStats{};
+        for (const auto& thread : m_searchThreads) {
+            m_searchStats.merge(thread.stats);
         }
+        m_searchStats.iterations = m_searchThreads.front().stats.iterations;
+        m_searchStats.threadCount = m_searchThreads.size();
+        m_searchStats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(TimeControl::Clock::now() - m_searchStart);
     }
-}
 
-void GameAI::tryToPlay(Gameboard& board)
-{
-    if (!m_threadOutput.empty()) {
-        Action action = m_threadOutput.poll();
-        assert(action.isValid(board));
-        action.execute(board);
-        board.switchTurn();
-    }
+    assert(best->bestAction && best->bestAction->isValid(searchBoard));
+    return *best->bestAction;
 }
 
-long GameAI::functionEval(const Gameboard& board)
+void GameAI::iterativeDeepening(SearchThread& thread, std::size_t index, const Bitboard& board)
 {
-    long score = 0;
-    int enemyDamage = 0;
+    Bitboard searchBoard{board};
 
-    std::vector<gf::Vector2i> myCharacterPositions{board.getTeamPositions(getTeam())};
-    std::vector<gf::Vector2i> otherCharacterPositions{board.getTeamPositions(getEnemyTeam(getTeam()))};
+    MoveList rootActions{};
+    searchBoard.getPossibleActions(rootActions);
+    assert(!rootActions.empty());
 
-    for (auto pos : otherCharacterPositions) {
-        auto character = board.getCharacter(pos);
-        enemyDamage = character.getHPMax() - character.getHP();
+    std::optional<Action> previousBestAction{};
+    if (auto known = m_transpositionTable.probe(searchBoard.getHash()); known && known->bestMove.isValid(searchBoard)) {
+        previousBestAction = known->bestMove;
     }
+    thread.moveOrdering.sort(searchBoard, rootActions, 0, previousBestAction);
 
-    score += enemyDamage * 15;
+    // The helpers search the actions in another order, after the first one, and one turn deeper every other thread
+    if (index > 0 && rootActions.size() > 2) {
+        std::size_t shift = 1 + (index - 1) % (rootActions.size() - 2);
+        std::rotate(rootActions.begin() + 1, rootActions.begin() + 1 + shift, rootActions.end());
+    }
+    const int firstDepth = 1 + static_cast<int>(index % 2);
+
+    for (int depth = firstDepth; depth <= maxDepth; ++depth) {
+        // The score is most likely close to the previous one, so the window around it prunes more
+        long window = aspirationWindow;
+        long alpha = -infiniteScore;
+        long beta = infiniteScore;
+        if (thread.completedDepth > 0 && !isWinScore(thread.score)) {
+            alpha = thread.score - window;
+            beta = thread.score + window;
+        }
 
-    //Check if you can attack
-    for (auto myPos : myCharacterPositions) {
-        for (auto otherPos : otherCharacterPositions) {
-            if (board.canAttack(myPos, otherPos)) {
-                score += 5;
+        long score = 0;
+        while (true) {
+            score = searchRoot(thread, searchBoard, rootActions, depth, alpha, beta);
+            if (m_stopSearch) {
+                break;
             }
 
-            if (board.canAttack(otherPos, myPos)) {
-                score -= 5;
+            // Search again with a wider window if the score is out of it
+            if (score <= alpha) {
+                alpha = std::max(score - window, -infiniteScore);
+            } else if (score >= beta) {
+                beta = std::min(score + window, infiniteScore);
+            } else {
+                break;
             }
+            window *= 2;
+        }
 
-            if (board.capacityWillHurt(myPos, otherPos)) {
-                score += 8;
-            }
+        if (m_stopSearch) {
+            break;
+        }
+
+        // The first iteration has nothing to change from
+        const bool bestActionChanged = thread.bestAction && *thread.bestAction != rootActions.front();
+        thread.bestAction = rootActions.front();
+        thread.completedDepth = depth;
+        thread.score = score;
+        m_transpositionTable.store(searchBoard.getHash(), depth, score, Bound::Exact, rootActions.front());
+        thread.stats.countStore();
+
+        if (isWinScore(score)) {
+            break;
+        }
+
+        // Only the main thread decides when the search is over
+        if (index == 0) {
+            thread.stats.addIteration(depth, score, thread.nodeCount,
+                                      std::chrono::duration_cast<std::chrono::microseconds>(TimeControl::Clock::now() - m_searchStart));
 
-            if (board.capacityWillHurt(otherPos, myPos)) {
-                score -= 8;
+            m_timeControl.completeIteration(bestActionChanged);
+            if (!m_timeControl.canStartIteration()) {
+                break;
             }
         }
     }
+}
 
-    //check if one player is on goal
-    score += 1000 * board.getNbOfActivatedGoals(getTeam());
-    score -= 1000 * board.getNbOfActivatedGoals(getEnemyTeam(getTeam()));
+long GameAI::searchRoot(SearchThread& thread, Bitboard& board, MoveList& rootActions, int depth, long alpha, long beta)
+{
+    thread.stats.countNode(0, false);
 
-    //check if one player has lost some characters
-    int nbOfDeadCharacters = Gameboard::charactersPerTeam - static_cast<int>(myCharacterPositions.size());
-    int nbOfEnemyDeadCharacters = Gameboard::charactersPerTeam - static_cast<int>(otherCharacterPositions.size());
+    const long originalAlpha = alpha;
+    long bestScore = -infiniteScore;
+    std::size_t bestIndex = 0;
 
-    if (nbOfDeadCharacters == Gameboard::charactersPerTeam - 1) {
-        return -9999;
-    }
+    for (std::size_t i = 0; i < rootActions.size(); ++i) {
+        long score = searchAction(thread, board, rootActions[i], depth, 0, alpha, beta, i == 0);
 
-    if (nbOfEnemyDeadCharacters == Gameboard::charactersPerTeam - 1) {
-        return 9999;
-    }
+        if (isSearchAborted(thread)) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestIndex = i;
+        }
 
-    if (nbOfDeadCharacters > 0) {
-        score -= nbOfDeadCharacters * 130;
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
+        }
     }
 
-    if (nbOfEnemyDeadCharacters > 0) {
-        score += nbOfEnemyDeadCharacters * 130;
+    // The best action is searched first by the next search, unless they all failed low
+    if (bestScore > originalAlpha) {
+        std::rotate(rootActions.begin(), rootActions.begin() + bestIndex, rootActions.begin() + bestIndex + 1);
     }
-    std::array<int, 2> max = {0, 0};
-    //Get points if you're near a goal
-    for (auto myPos : myCharacterPositions) {
-        auto goalDistances = board.getGoalsDistance(myPos);
-        for (std::size_t i = 0; i < max.size(); ++i) {
-            max[i] = std::max(max[i], std::abs((125 - goalDistances[(getTeam() == PlayerTeam::Cthulhu) ? i : (i+2)])));
+
+    return bestScore;
+}
+
+long GameAI::searchAction(SearchThread& thread, Bitboard& board, const Action& action, int depth, int ply, long alpha, long beta, bool isFirst)
+{
+    auto record = action.executeReversibly(board);
+    board.switchTurn();
+
+    long score = 0;
+    if (isFirst) {
+        score = -alphaBeta(thread, board, depth - 1, ply + 1, -beta, -alpha);
+    } else {
+        // Only prove the action is not better than the first one, unless it is
+        score = -alphaBeta(thread, board, depth - 1, ply + 1, -alpha - 1, -alpha);
+        if (score > alpha && score < beta) {
+            score = -alphaBeta(thread, board, depth - 1, ply + 1, -beta, -alpha);
         }
     }
-    score += max[0];
-    score += max[1];
+
+    board.switchTurn();
+    action.undo(board, record);
 
     return score;
 }
 
-GameAI::depthActionsExploration GameAI::bestActionInFuture(const Gameboard& board, unsigned int depth)
+long GameAI::alphaBeta(SearchThread& thread, Bitboard& board, int depth, int ply, long alpha, long beta)
 {
-    std::vector<Action> allActions = board.getPossibleActions();
-    std::vector<Gameboard> boardsToAnalyse;
+    // The leaves are counted by the quiescence search, as quiescence nodes
+    if (depth <= 0) {
+        return quiescence(thread, board, maxQuiescenceDepth, ply, alpha, beta);
+    }
 
-    for (auto actionAvailable : allActions) {
-        assert(actionAvailable.isValid(board));
-        Gameboard anOtherBoard{board};
-        actionAvailable.execute(anOtherBoard);
-        boardsToAnalyse.push_back(anOtherBoard);
+    ++thread.nodeCount;
+    thread.stats.countNode(ply, false);
+    if (m_stopSearch.load(std::memory_order_relaxed)) {
+        return 0;
     }
 
-    long bestScore = -10000;
-    Action bestAction = allActions.front();
-    if (depth == 0) {
-        long score = 0;
-        for (auto actionAvailable : allActions) {
-            if (actionAvailable.getType() != ActionType::None && actionAvailable.isValid(board)) {
-                assert(actionAvailable.isValid(board));
-
-                Gameboard anOtherBoard{board};
-                actionAvailable.execute(anOtherBoard);
-                score = functionEval(anOtherBoard);
-
-                if (score > bestScore) {
-                    bestAction = actionAvailable;
-                    bestScore = score;
-                }
-            }
+    PlayerTeam team = board.getPlayingTeam();
+    if (board.hasWon(getEnemyTeam(team))) {
+        return -winScore + ply;
+    }
+    if (board.hasWon(team)) {
+        return winScore - ply;
+    }
+
+    // No win found from here can be faster than a win already found closer to the root
+    alpha = std::max(alpha, -winScore + ply);
+    beta = std::min(beta, winScore - ply - 1);
+    if (alpha >= beta) {
+        return alpha;
+    }
+
+    const long originalAlpha = alpha;
+    std::optional<Action> knownBestAction{};
+    auto known = m_transpositionTable.probe(board.getHash());
+    thread.stats.countProbe(known.has_value());
+    if (known) {
+        const long knownScore = scoreFromTable(known->score, ply);
+        if (known->depth >= depth &&
+            (known->bound == Bound::Exact ||
+             (known->bound == Bound::Lower && knownScore >= beta) ||
+             (known->bound == Bound::Upper && knownScore <= alpha))) {
+            return knownScore;
         }
-        depthActionsExploration actionToDo = std::make_pair(bestAction, std::make_pair(bestScore, bestScore));
-        //        if (actionToDo.first.getType() == ActionType::Attack) {
-        //            std::cout << "Attaque\n";
-        //        }
-        //        if (actionToDo.first.getType() == ActionType::Capacity) {
-        //            std::cout << "Capacité\n";
-        //        }
-        //        if (actionToDo.first.getType() == ActionType::None) {
-        //            std::cout << "None\n";
-        //        }
-        //std::cout << "Bottom reached. " << bestScore << "\n";
-
-        assert(actionToDo.first.isValid(board));
-        return actionToDo;
-    } else {
-        std::vector<depthActionsExploration> allPossibilities;
-        long score = 0;
-        for (auto actionAvailable : allActions) {
-            Gameboard anOtherBoard{board};
-            actionAvailable.execute(anOtherBoard);
-            score = functionEval(anOtherBoard);
-            boardsToAnalyse.push_back(anOtherBoard);
-            if (score > bestScore) {
-                bestAction = actionAvailable;
-                bestScore = score;
-            }
+        knownBestAction = known->bestMove;
+    }
+
+    MoveList actions{};
+    board.getPossibleActions(actions);
+    if (actions.empty()) {
+        thread.stats.countEvaluation();
+        return evaluateForPlayingTeam(board);
+    }
+    thread.moveOrdering.sort(board, actions, ply, knownBestAction);
+
+    long bestScore = -infiniteScore;
+    Action bestAction = actions.front();
+
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        const Action& action = actions[i];
+        long score = searchAction(thread, board, action, depth, ply, alpha, beta, i == 0);
+
+        if (isSearchAborted(thread)) {
+            return 0;
         }
 
-        if (bestScore == 9999) {
-            assert(bestAction.isValid(board));
-            return std::make_pair(bestAction, std::make_pair(bestScore, bestScore));
+        if (score > bestScore) {
+            bestScore = score;
+            bestAction = action;
         }
 
-        for (const auto& currentBoard : boardsToAnalyse) {
-            allPossibilities.push_back(bestActionInFuture(currentBoard, depth - 1));
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            thread.moveOrdering.addCutoff(board, action, ply, depth);
+            thread.stats.countCutoff(i);
+            break;
         }
-        long bestScoreRow = -10000; // So if the "best action" is to lose with a -9999 score it will be possible
-        for (auto tab : allPossibilities) {
-            if (tab.second.second > bestScoreRow && tab.first.isValid(board)) {
-                bestScoreRow = tab.second.second;
-                bestScore = tab.second.first;
-                bestAction = tab.first;
-            }
+    }
+
+    Bound bound = Bound::Exact;
+    if (bestScore <= originalAlpha) {
+        bound = Bound::Upper;
+    } else if (bestScore >= beta) {
+        bound = Bound::Lower;
+    }
+    m_transpositionTable.store(board.getHash(), depth, scoreToTable(bestScore, ply), bound, bestAction);
+    thread.stats.countStore();
+
+    return bestScore;
+}
+
+long GameAI::quiescence(SearchThread& thread, Bitboard& board, int depth, int ply, long alpha, long beta)
+{
+    ++thread.nodeCount;
+    thread.stats.countNode(ply, true);
+    if (m_stopSearch.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+
+    PlayerTeam team = board.getPlayingTeam();
+    if (board.hasWon(getEnemyTeam(team))) {
+        return -winScore + ply;
+    }
+    if (board.hasWon(team)) {
+        return winScore - ply;
+    }
+
+    // The playing team can do a quiet action instead, so it gets at least the score of the state
+    const long standPat = evaluateForPlayingTeam(board);
+    thread.stats.countEvaluation();
+    if (standPat >= beta || depth == 0 || ply >= MoveOrdering::maxPly) {
+        return standPat;
+    }
+    alpha = std::max(alpha, standPat);
+
+    // Only the actions which hurt an enemy are searched, the list is filtered in place to keep a single one on the stack
+    MoveList actions{};
+    board.getPossibleActions(actions);
+    actions.removeIf([&board, team](const Action& action) {
+        return !MoveOrdering::isTactical(board, action) || board.getTeamFor(action.getTarget()) == team;
+    });
+    thread.moveOrdering.sort(board, actions, ply, std::nullopt);
+
+    long bestScore = standPat;
+    for (const auto& action : actions) {
+        auto record = action.executeReversibly(board);
+        board.switchTurn();
+        long score = -quiescence(thread, board, depth - 1, ply + 1, -beta, -alpha);
+        board.switchTurn();
+        action.undo(board, record);
+
+        if (isSearchAborted(thread)) {
+            return 0;
+        }
+
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
         }
-        depthActionsExploration actionToDo = std::make_pair(bestAction, std::make_pair(bestScore, bestScoreRow));
-        std::cout << "Best score  = " << bestScore << " Best Score reached = " << bestScoreRow << "\n";
-        //            if (actionToDo.first.getType() == ActionType::Attack) {
-        //                std::cout << "Attaque\n";
-        //            }
-        //            if (actionToDo.first.getType() == ActionType::Capacity) {
-        //                std::cout << "Capacité\n";
-        //            }
-        //            if (actionToDo.first.getType() == ActionType::None) {
-        //                std::cout << "None\n";
-        //            }
-
-
-        assert(actionToDo.first.isValid(board));
-        //board.display();
-        return actionToDo;
     }
+
+    return bestScore;
+}
+
+bool GameAI::isSearchAborted(const SearchThread& thread)
+{
+    const bool isMainThread = &thread == &m_searchThreads.front();
+    const bool isPolled = thread.nodeCount % TimeControl::nodesBetweenChecks == 0;
+    if (isMainThread && thread.completedDepth > 0 &&
+        (m_timeControl.isHardCapReached(thread.nodeCount) || (isPolled && (!m_gameOpen || !m_threadInput.empty())))) {
+        m_stopSearch = true;
+    }
+
+    return m_stopSearch.load(std::memory_order_relaxed);
 }
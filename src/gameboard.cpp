@@ -1,20 +1,19 @@
 #include "gameboard.h"
 
 #include "action.h"
+#include "bitboard.h"
+#include "movelist.h"
+#include "undorecord.h"
 
 #include <gf/Orientation.h>
 
 #include <bitset>
-#include <iostream>
+#include <ostream>
+#include <utility>
 
 Gameboard::Gameboard() :
     m_array{getSize(), std::nullopt},
-    m_goals{
-            Goal{PlayerTeam::Cthulhu, {10, 1}},
-            Goal{PlayerTeam::Cthulhu, {10, 4}},
-            Goal{PlayerTeam::Satan, {1, 1}},
-            Goal{PlayerTeam::Satan, {1, 4}},
-    }
+    m_goals{goalLayout}
 {
     auto initPlayerCharacters{[this](int column, PlayerTeam team) {
         gf::Vector2i pos{column, 0};
@@ -22,6 +21,7 @@ Gameboard::Gameboard() :
         auto addCharacterInColumn{[this, &pos, &team](CharacterType type) {
             assert(m_array.isValid(pos));
             m_array(pos) = Character{team, type};
+            m_hash ^= getTileKey(pos);
             ++pos.y;
         }};
 
@@ -37,25 +37,91 @@ Gameboard::Gameboard() :
     initPlayerCharacters(9, PlayerTeam::Satan);
 }
 
-[[nodiscard]] std::vector<Action> Gameboard::getPossibleActions(const gf::Vector2i& origin) const
+Gameboard::Gameboard(const Bitboard& board) :
+    m_array{getSize(), std::nullopt},
+    m_goals{goalLayout},
+    m_playingTeam{board.getPlayingTeam()},
+    m_hash{getPlayingTeamKey(board.getPlayingTeam())}
 {
-    std::vector<Action> res = std::vector<Action>{};
-    std::set<gf::Vector2i, PositionComp> possibleMovements = getAllPossibleMoves(origin);
-    for (auto possibleMovement : possibleMovements) {
-        res.emplace_back(origin, possibleMovement);
-
-        std::set<gf::Vector2i, PositionComp> possibleCapacities = getAllPossibleCapacities(possibleMovement, origin);
-        for (auto possibleCapacity : possibleCapacities) {
-            res.emplace_back(ActionType::Capacity, origin, possibleMovement, possibleCapacity);
+    forEach([this, &board](auto pos) {
+        if (board.isOccupied(pos)) {
+            m_array(pos) = board.getCharacter(pos);
+            m_hash ^= getTileKey(pos);
         }
+    });
 
-        std::set<gf::Vector2i, PositionComp> possibleAttacks = getAllPossibleAttacks(possibleMovement, origin);
-        for (auto possibleAttack : possibleAttacks) {
-            res.emplace_back(ActionType::Attack, origin, possibleMovement, possibleAttack);
+    for (std::size_t i = 0; i < m_goals.size(); ++i) {
+        if (board.isGoalActivated(i)) {
+            m_goals[i].activate();
+            m_hash ^= getGoalKey(i);
         }
     }
+}
 
-    return res;
+Gameboard::Gameboard(const Gameboard& other) :
+    m_array{other.m_array},
+    m_goals{other.m_goals},
+    m_playingTeam{other.m_playingTeam},
+    m_hash{other.m_hash}
+{
+    // Nothing
+}
+
+Gameboard::Gameboard(Gameboard&& other) noexcept :
+    m_array{std::move(other.m_array)},
+    m_goals{other.m_goals},
+    m_playingTeam{other.m_playingTeam},
+    m_hash{other.m_hash}
+{
+    // Nothing
+}
+
+Gameboard& Gameboard::operator=(const Gameboard& other)
+{
+    m_array = other.m_array;
+    m_goals = other.m_goals;
+    m_playingTeam = other.m_playingTeam;
+    m_hash = other.m_hash;
+
+    return *this;
+}
+
+Gameboard& Gameboard::operator=(Gameboard&& other) noexcept
+{
+    m_array = std::move(other.m_array);
+    m_goals = other.m_goals;
+    m_playingTeam = other.m_playingTeam;
+    m_hash = other.m_hash;
+
+    return *this;
+}
+
+void Gameboard::getPossibleActions(const gf::Vector2i& origin, MoveList& actions) const
+{
+    CharacterType type = getTypeFor(origin);
+
+    for (auto moveSquare : getMoveTargets(type, BoardMask::toSquare(origin))) {
+        gf::Vector2i possibleMovement = BoardMask::toPosition(moveSquare);
+        if (!canMove(origin, possibleMovement)) {
+            continue;
+        }
+
+        actions.emplace(origin, possibleMovement);
+
+        for (auto square : getCapacityTargets(type, moveSquare)) {
+            gf::Vector2i possibleCapacity = BoardMask::toPosition(square);
+            if (canUseCapacity(possibleMovement, possibleCapacity, origin)) {
+                actions.emplace(ActionType::Capacity, origin, possibleMovement, possibleCapacity);
+            }
+        }
+
+        for (auto square : getAttackTargets(type, moveSquare)) {
+            gf::Vector2i possibleAttack = BoardMask::toPosition(square);
+            if (canAttack(possibleMovement, possibleAttack, origin)) {
+                actions.emplace(ActionType::Attack, origin, possibleMovement, possibleAttack);
+            }
+        }
+    }
 }
 
 bool Gameboard::attack(const gf::Vector2i& origin, const gf::Vector2i& dest)
@@ -65,8 +131,10 @@ bool Gameboard::attack(const gf::Vector2i& origin, const gf::Vector2i& dest)
     if (success) {
         assert(isOccupied(origin));
         assert(isOccupied(dest));
+        m_hash ^= getTileKey(dest);
         m_array(origin)->attack(*m_array(dest));
-        pushLastHPChange(dest, m_array(dest)->getHP());
+        m_hash ^= getTileKey(dest);
+        notifyHP(dest, m_array(dest)->getHP());
         removeIfDead(dest);
     }
 
@@ -121,7 +189,7 @@ bool Gameboard::move(const gf::Vector2i& origin, const gf::Vector2i& dest)
 
     if (success) {
         swapPositions(origin, dest);
-        pushLastMove(origin, dest);
+        notifyMove(origin, dest);
     }
 
     return success;
@@ -158,13 +226,13 @@ bool Gameboard::useCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest
 
     switch (getTypeFor(origin)) {
     case CharacterType::Scout: {
-        pushLastMove(origin, dest);
+        notifyMove(origin, dest);
         swapOccupiedPositions(origin, dest);
     } break;
 
     case CharacterType::Tank: {
         gf::Vector2i newPos = origin + gf::sign(dest - origin);
-        pushLastMove(dest, newPos);
+        notifyMove(dest, newPos);
         swapPositions(dest, newPos);
     } break;
 
@@ -177,12 +245,14 @@ bool Gameboard::useCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest
         gf::Vector2i ejectedPos = dest + ejectionDistance * gf::sign(dest - origin);
 
         if (!isTargetReachable(dest, ejectedPos)) {
+            m_hash ^= getTileKey(dest);
             m_array(dest)->damage(ejectionDamage);
+            m_hash ^= getTileKey(dest);
             ejectedPos = getLastReachablePos(dest, ejectedPos);
-            pushLastMove(dest, ejectedPos);
-            pushLastHPChange(ejectedPos, m_array(dest)->getHP());
+            notifyMove(dest, ejectedPos);
+            notifyHP(ejectedPos, m_array(dest)->getHP());
         } else {
-            pushLastMove(dest, ejectedPos);
+            notifyMove(dest, ejectedPos);
         }
 
         swapPositions(dest, ejectedPos);
@@ -224,49 +294,45 @@ bool Gameboard::useCapacity(const gf::Vector2i& origin, const gf::Vector2i& dest
     return Ability::Unable;
 }
 
-[[nodiscard]] std::vector<Action> Gameboard::getPossibleActions() const
+void Gameboard::getPossibleActions(MoveList& actions) const
 {
-    std::vector<Action> results{};
-    forEach([this, &results](auto pos) {
+    forEach([this, &actions](auto pos) {
         if (isOccupied(pos) && getTeamFor(pos) == m_playingTeam) {
-            auto characterActions = getPossibleActions(pos);
-            results.insert(results.end(), characterActions.begin(), characterActions.end());
+            getPossibleActions(pos, actions);
         }
     });
-
-    return results;
 }
 
-void Gameboard::display() const
+void Gameboard::display(std::ostream& out) const
 {
     for (gf::Vector2i pos{0, 0}, size = m_array.getSize(); pos.y < size.height; ++pos.y) {
         for (pos.x = 0; pos.x < size.width; ++pos.x) {
             if (m_array(pos)) {
                 switch (getTypeFor(pos)) {
-                case CharacterType::Tank:std::cout << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "T" : "t");
+                case CharacterType::Tank:out << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "T" : "t");
                     break;
 
-                case CharacterType::Scout:std::cout << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "E" : "e");
+                case CharacterType::Scout:out << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "E" : "e");
                     break;
 
-                case CharacterType::Support:std::cout << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "S" : "s");
+                case CharacterType::Support:out << ((getTeamFor(pos) == PlayerTeam::Cthulhu) ? "S" : "s");
                     break;
                 }
             } else if (isGoal(pos, PlayerTeam::Cthulhu) || isGoal(pos, PlayerTeam::Satan)) {
                 for (auto& goal : m_goals) {
                     if (goal.getPosition() == pos) {
-                        std::cout << (goal.isActivated() ? "X" : "O");
+                        out << (goal.isActivated() ? "X" : "O");
                     }
                 }
             } else {
-                std::cout << " ";
+                out << " ";
             }
-            std::cout << " ";
+            out << " ";
         }
-        std::cout << "\n";
+        out << "\n";
     }
 
-    std::cout << "Playing: " << ((m_playingTeam == PlayerTeam::Cthulhu) ? "Cthulhu" : "Satan") << std::endl;
+    out << "Playing: " << ((m_playingTeam == PlayerTeam::Cthulhu) ? "Cthulhu" : "Satan");
 }
 
 [[nodiscard]] int Gameboard::getNbOfActivatedGoals(PlayerTeam team) const
@@ -281,6 +347,38 @@ void Gameboard::display() const
     return result;
 }
 
+[[nodiscard]] std::uint8_t Gameboard::getActivatedGoals() const
+{
+    std::uint8_t result = 0;
+    for (std::size_t i = 0; i < m_goals.size(); ++i) {
+        if (m_goals[i].isActivated()) {
+            result |= static_cast<std::uint8_t>(1U << i);
+        }
+    }
+
+    return result;
+}
+
+void Gameboard::restore(const UndoRecord& record)
+{
+    record.doWithTiles([this](const gf::Vector2i& pos, const std::optional<Character>& character) {
+        m_hash ^= getTileKey(pos);
+        m_array(pos) = character;
+        m_hash ^= getTileKey(pos);
+    });
+
+    for (std::size_t i = 0; i < m_goals.size(); ++i) {
+        if (m_goals[i].isActivated()) {
+            m_hash ^= getGoalKey(i);
+        }
+        m_goals[i] = goalLayout[i];
+        if ((record.getActivatedGoals() & (1U << i)) != 0) {
+            m_goals[i].activate();
+            m_hash ^= getGoalKey(i);
+        }
+    }
+}
+
 [[nodiscard]] std::vector<gf::Vector2i> Gameboard::getTeamPositions(PlayerTeam team) const
 {
     std::vector<gf::Vector2i> results{};
@@ -388,9 +486,10 @@ void Gameboard::display() const
 
 void Gameboard::tryGoalActivation(PlayerTeam team, const gf::Vector2i& position)
 {
-    for (auto& goal : m_goals) {
-        if (goal.getPosition() == position && goal.getTeam() == team) {
-            goal.activate();
+    for (std::size_t i = 0; i < m_goals.size(); ++i) {
+        if (m_goals[i].getPosition() == position && m_goals[i].getTeam() == team && !m_goals[i].isActivated()) {
+            m_goals[i].activate();
+            m_hash ^= getGoalKey(i);
         }
     }
 }
@@ -449,12 +548,16 @@ void Gameboard::tryGoalActivation(PlayerTeam team, const gf::Vector2i& position)
 
 [[nodiscard]] std::set<gf::Vector2i, PositionComp> Gameboard::getAllPossibleActionsOfAType(
     Ability (Gameboard::*canDoSomething)(const gf::Vector2i&, const gf::Vector2i&, const gf::Vector2i&) const,
+    const TargetList& (*getTargets)(CharacterType, int),
     const gf::Vector2i& origin,
     const gf::Vector2i& executor,
     bool usedForNotPossibleDisplay) const
 {
+    assert(m_array.isValid(origin));
+
     std::set<gf::Vector2i, PositionComp> res;
-    forEach([this, &canDoSomething, &origin, &executor, &usedForNotPossibleDisplay, &res](auto pos) {
+    for (auto square : getTargets(getTypeFor(executor), BoardMask::toSquare(origin))) {
+        gf::Vector2i pos = BoardMask::toPosition(square);
         Ability possibleAction = (this->*canDoSomething)(origin, pos, executor);
         if (usedForNotPossibleDisplay) {
             if (possibleAction != Ability::Unable) {
@@ -463,7 +566,7 @@ void Gameboard::tryGoalActivation(PlayerTeam team, const gf::Vector2i& position)
         } else if (possibleAction == Ability::Able) {
             res.insert(pos);
         }
-    });
+    }
     return res;
 }
 
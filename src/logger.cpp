@@ -0,0 +1,105 @@
+#include "logger.h"
+#include "mpscqueue.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <cstdint>
+
+namespace {
+constexpr std::size_t queueCapacity = 1024;
+
+/**
+ * A message waiting to be written
+ */
+struct Message {
+    LogLevel level;
+    std::string text;
+};
+
+[[nodiscard]] const char* getLevelName(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Debug:
+        return "[debug] ";
+    case LogLevel::Info:
+        return "[info] ";
+    case LogLevel::Warning:
+        return "[warning] ";
+    case LogLevel::Error:
+        return "[error] ";
+    }
+
+    return "";
+}
+
+/**
+ * The queue of the messages and the thread writing them
+ *
+ * It is made when the first message is logged and destroyed at the end of the
+ * program, once all the messages are written.
+ */
+class LogWriter {
+public:
+    LogWriter() = default;
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    ~LogWriter()
+    {
+        m_messages.close();
+        m_thread.join();
+    }
+
+    void push(Message&& message)
+    {
+        if (!m_messages.tryPush(std::move(message))) {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    void writeMessages()
+    {
+        while (auto message = m_messages.waitPop()) {
+            if (auto droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed); droppedCount > 0) {
+                std::clog << getLevelName(LogLevel::Warning) << droppedCount << " messages dropped\n";
+            }
+
+            std::clog << getLevelName(message->level) << message->text;
+            if (message->text.empty() || message->text.back() != '\n') {
+                std::clog << '\n';
+            }
+
+            // Flushed once all the messages known are written, not after each one
+            if (m_messages.empty()) {
+                std::clog.flush();
+            }
+        }
+        std::clog.flush();
+    }
+
+    MpscQueue<Message, queueCapacity> m_messages{};
+    std::atomic<std::uint64_t> m_droppedCount{0};
+    std::thread m_thread{&LogWriter::writeMessages, this}; ///< Started last, once everything it uses is constructed
+};
+
+std::atomic<LogLevel> logLevel{LogLevel::Info};
+} // namespace
+
+void Logger::setLevel(LogLevel level)
+{
+    logLevel.store(level, std::memory_order_relaxed);
+}
+
+[[nodiscard]] bool Logger::isEnabled(LogLevel level)
+{
+    return level >= logLevel.load(std::memory_order_relaxed);
+}
+
+void Logger::push(LogLevel level, std::string&& message)
+{
+    static LogWriter writer{};
+    writer.push(Message{level, std::move(message)});
+}
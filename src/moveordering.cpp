@@ -0,0 +1,130 @@
+#include "moveordering.h"
+
+#include <gf/VectorOps.h>
+
+#include <algorithm>
+
+#include <cassert>
+
+namespace {
+constexpr int bestActionScore = 1 << 30;
+constexpr int tacticalScore = 1 << 24;
+constexpr int killScore = 1 << 20;
+constexpr std::array<int, 2> killerScores{1 << 22, (1 << 22) - 1};
+constexpr int maxHistory = 1 << 21; ///< Kept below the score of the killer actions
+
+constexpr int supportEjectionDamage = 4; ///< As in Gameboard::useCapacity
+} // namespace
+
+void MoveOrdering::sort(const Bitboard& board, MoveList& actions, int ply, const std::optional<Action>& bestAction) const
+{
+    std::array<int, MoveList::capacity> scores; // Not initialized, only the first actions.size() scores are used
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        scores[i] = (bestAction && actions[i] == *bestAction) ? bestActionScore : getScore(board, actions[i], ply);
+    }
+
+    // Insertion sort: the lists are short and it keeps the generation order between equal scores
+    for (std::size_t i = 1; i < actions.size(); ++i) {
+        Action action = actions[i];
+        int score = scores[i];
+
+        std::size_t j = i;
+        for (; j > 0 && scores[j - 1] < score; --j) {
+            actions[j] = actions[j - 1];
+            scores[j] = scores[j - 1];
+        }
+
+        actions[j] = action;
+        scores[j] = score;
+    }
+}
+
+void MoveOrdering::addCutoff(const Bitboard& board, const Action& action, int ply, int depth)
+{
+    if (isTactical(board, action)) {
+        return;
+    }
+
+    if (ply < maxPly) {
+        auto& killers = m_killers[static_cast<std::size_t>(ply)];
+        if (killers[0] != action) {
+            killers[1] = killers[0];
+            killers[0] = action;
+        }
+    }
+
+    int& history = getHistory(board, action);
+    history = std::min(history + depth * depth, maxHistory);
+}
+
+void MoveOrdering::age()
+{
+    m_killers = {};
+
+    for (auto& fromType : m_history) {
+        for (auto& fromSquare : fromType) {
+            for (auto& history : fromSquare) {
+                history /= 2;
+            }
+        }
+    }
+}
+
+[[nodiscard]] bool MoveOrdering::isTactical(const Bitboard& board, const Action& action)
+{
+    switch (action.getType()) {
+    case ActionType::Attack:
+        return true;
+
+    case ActionType::Capacity: {
+        if (board.getTypeFor(action.getOrigin()) != CharacterType::Support) {
+            return false;
+        }
+
+        // The ejected character is hurt if something stops it
+        gf::Vector2i direction = gf::sign(action.getTarget() - action.getDest());
+        auto isBlocking = [&board, &action](const gf::Vector2i& pos) {
+            return !BoardMask::isValid(pos) || (board.isOccupied(pos) && pos != action.getOrigin());
+        };
+        return isBlocking(action.getTarget() + direction) || isBlocking(action.getTarget() + 2 * direction);
+    }
+
+    case ActionType::None:
+        break;
+    }
+
+    return false;
+}
+
+[[nodiscard]] int MoveOrdering::getScore(const Bitboard& board, const Action& action, int ply) const
+{
+    if (isTactical(board, action)) {
+        assert(board.isOccupied(action.getTarget()));
+
+        CharacterType victimType = board.getTypeFor(action.getTarget());
+        int victimHP = board.getHPFor(action.getTarget());
+        int damage = (action.getType() == ActionType::Attack)
+                             ? Character::getDamageForType(board.getTypeFor(action.getOrigin()))
+                             : supportEjectionDamage;
+
+        int score = tacticalScore + 16 * Character::getDamageForType(victimType) - victimHP;
+        if (board.getTeamFor(action.getTarget()) == board.getPlayingTeam()) {
+            return score - 2 * tacticalScore; // Hurting an ally is searched last
+        }
+        if (damage >= victimHP) {
+            score += killScore;
+        }
+        return score;
+    }
+
+    if (ply < maxPly) {
+        const auto& killers = m_killers[static_cast<std::size_t>(ply)];
+        for (std::size_t i = 0; i < killers.size(); ++i) {
+            if (killers[i] == action) {
+                return killerScores[i];
+            }
+        }
+    }
+
+    return getHistory(board, action);
+}
@@ -0,0 +1,124 @@
+#include "referencepositions.h"
+
+#include <cassert>
+
+namespace {
+const std::array<ReferencePosition, 4> referencePositions{
+    ReferencePosition{"Beginning", {}},
+    ReferencePosition{"Opening, 12 actions", {
+        Action{ActionType::None, {2, 4}, {1, 2}, {2, 4}},
+        Action{ActionType::Capacity, {9, 5}, {7, 3}, {9, 1}},
+        Action{ActionType::None, {1, 2}, {1, 2}, {1, 2}},
+        Action{ActionType::Capacity, {9, 1}, {9, 1}, {7, 3}},
+        Action{ActionType::Capacity, {1, 2}, {2, 4}, {2, 2}},
+        Action{ActionType::Capacity, {9, 0}, {7, 0}, {9, 2}},
+        Action{ActionType::Capacity, {2, 4}, {4, 3}, {2, 3}},
+        Action{ActionType::Capacity, {9, 2}, {10, 1}, {9, 2}},
+        Action{ActionType::Capacity, {2, 5}, {1, 4}, {2, 5}},
+        Action{ActionType::Capacity, {9, 3}, {10, 3}, {10, 1}},
+        Action{ActionType::None, {1, 4}, {1, 4}, {1, 4}},
+        Action{ActionType::Capacity, {10, 2}, {11, 3}, {10, 2}},
+    }},
+    ReferencePosition{"Middle game, 30 actions, an activated goal", {
+        Action{ActionType::Capacity, {2, 1}, {0, 0}, {2, 0}},
+        Action{ActionType::Capacity, {9, 0}, {7, 2}, {9, 4}},
+        Action{ActionType::Capacity, {2, 5}, {0, 3}, {2, 5}},
+        Action{ActionType::None, {9, 3}, {8, 2}, {9, 3}},
+        Action{ActionType::None, {2, 3}, {2, 3}, {2, 3}},
+        Action{ActionType::None, {9, 1}, {7, 0}, {9, 1}},
+        Action{ActionType::Capacity, {4, 0}, {6, 0}, {8, 2}},
+        Action{ActionType::Attack, {9, 2}, {8, 3}, {8, 2}},
+        Action{ActionType::Capacity, {2, 3}, {2, 3}, {0, 3}},
+        Action{ActionType::Attack, {7, 2}, {5, 3}, {2, 3}},
+        Action{ActionType::Capacity, {8, 2}, {8, 2}, {6, 0}},
+        Action{ActionType::Attack, {5, 3}, {3, 2}, {2, 2}},
+        Action{ActionType::None, {6, 0}, {7, 1}, {6, 0}},
+        Action{ActionType::None, {3, 2}, {3, 2}, {3, 2}},
+        Action{ActionType::Capacity, {1, 3}, {1, 5}, {2, 4}},
+        Action{ActionType::Capacity, {8, 2}, {9, 1}, {9, 4}},
+        Action{ActionType::Capacity, {7, 1}, {8, 1}, {9, 2}},
+        Action{ActionType::Capacity, {8, 3}, {7, 3}, {7, 0}},
+        Action{ActionType::Capacity, {0, 0}, {2, 1}, {2, 3}},
+        Action{ActionType::None, {9, 1}, {9, 0}, {9, 1}},
+        Action{ActionType::Capacity, {2, 2}, {1, 2}, {1, 5}},
+        Action{ActionType::Attack, {8, 1}, {9, 1}, {9, 2}},
+        Action{ActionType::Capacity, {2, 4}, {3, 5}, {1, 3}},
+        Action{ActionType::None, {9, 1}, {10, 1}, {9, 1}},
+        Action{ActionType::Capacity, {1, 3}, {1, 4}, {3, 2}},
+        Action{ActionType::Attack, {1, 4}, {3, 3}, {2, 3}},
+        Action{ActionType::Attack, {3, 5}, {2, 3}, {3, 3}},
+        Action{ActionType::Capacity, {7, 2}, {5, 3}, {7, 3}},
+        Action{ActionType::None, {2, 3}, {2, 3}, {2, 3}},
+        Action{ActionType::Capacity, {3, 3}, {1, 4}, {1, 2}},
+    }},
+    ReferencePosition{"End game, 50 actions, 3 characters against 5", {
+        Action{ActionType::None, {2, 1}, {3, 3}, {2, 1}},
+        Action{ActionType::Capacity, {9, 0}, {7, 2}, {9, 0}},
+        Action{ActionType::Capacity, {2, 4}, {2, 4}, {2, 2}},
+        Action{ActionType::Capacity, {9, 5}, {11, 5}, {9, 3}},
+        Action{ActionType::None, {3, 3}, {3, 3}, {3, 3}},
+        Action{ActionType::Capacity, {9, 3}, {11, 1}, {9, 3}},
+        Action{ActionType::None, {2, 0}, {0, 2}, {2, 0}},
+        Action{ActionType::None, {11, 1}, {11, 1}, {11, 1}},
+        Action{ActionType::None, {0, 2}, {0, 3}, {0, 2}},
+        Action{ActionType::Capacity, {7, 2}, {5, 4}, {7, 2}},
+        Action{ActionType::Capacity, {2, 5}, {3, 5}, {2, 4}},
+        Action{ActionType::None, {11, 1}, {10, 2}, {11, 1}},
+        Action{ActionType::None, {3, 5}, {3, 5}, {3, 5}},
+        Action{ActionType::Capacity, {9, 1}, {11, 2}, {9, 2}},
+        Action{ActionType::Capacity, {2, 4}, {3, 4}, {2, 3}},
+        Action{ActionType::Capacity, {11, 5}, {11, 5}, {11, 2}},
+        Action{ActionType::Capacity, {0, 3}, {2, 5}, {3, 4}},
+        Action{ActionType::Attack, {5, 4}, {3, 2}, {3, 3}},
+        Action{ActionType::Capacity, {3, 5}, {3, 5}, {3, 3}},
+        Action{ActionType::Capacity, {9, 4}, {8, 2}, {10, 2}},
+        Action{ActionType::None, {2, 1}, {3, 0}, {2, 1}},
+        Action{ActionType::None, {3, 2}, {2, 1}, {3, 2}},
+        Action{ActionType::Capacity, {2, 5}, {1, 4}, {3, 4}},
+        Action{ActionType::Capacity, {2, 1}, {4, 3}, {2, 1}},
+        Action{ActionType::Capacity, {2, 3}, {3, 2}, {1, 4}},
+        Action{ActionType::Capacity, {4, 3}, {4, 2}, {2, 4}},
+        Action{ActionType::Capacity, {4, 2}, {6, 4}, {8, 2}},
+        Action{ActionType::Attack, {2, 4}, {3, 4}, {3, 5}},
+        Action{ActionType::Attack, {3, 2}, {3, 3}, {3, 4}},
+        Action{ActionType::Attack, {7, 2}, {7, 2}, {8, 2}},
+        Action{ActionType::Capacity, {1, 4}, {0, 5}, {1, 4}},
+        Action{ActionType::None, {7, 2}, {7, 3}, {7, 2}},
+        Action{ActionType::Attack, {8, 2}, {8, 3}, {7, 3}},
+        Action{ActionType::Capacity, {7, 3}, {8, 4}, {6, 4}},
+        Action{ActionType::Capacity, {3, 3}, {3, 2}, {3, 0}},
+        Action{ActionType::Capacity, {3, 4}, {1, 4}, {0, 5}},
+        Action{ActionType::Capacity, {3, 2}, {3, 4}, {3, 2}},
+        Action{ActionType::None, {7, 4}, {7, 4}, {7, 4}},
+        Action{ActionType::Capacity, {1, 4}, {2, 5}, {3, 4}},
+        Action{ActionType::Capacity, {8, 4}, {9, 5}, {11, 5}},
+        Action{ActionType::Capacity, {8, 3}, {10, 1}, {8, 3}},
+        Action{ActionType::Capacity, {9, 5}, {8, 4}, {11, 4}},
+        Action{ActionType::Capacity, {3, 1}, {3, 1}, {3, 4}},
+        Action{ActionType::Capacity, {7, 4}, {5, 5}, {3, 5}},
+        Action{ActionType::Capacity, {3, 2}, {4, 3}, {2, 5}},
+        Action{ActionType::None, {8, 4}, {8, 5}, {8, 4}},
+        Action{ActionType::None, {4, 3}, {4, 3}, {4, 3}},
+        Action{ActionType::Capacity, {10, 5}, {11, 4}, {9, 4}},
+        Action{ActionType::Capacity, {4, 3}, {5, 3}, {5, 5}},
+        Action{ActionType::Attack, {10, 4}, {10, 4}, {10, 1}},
+    }},
+};
+} // namespace
+
+[[nodiscard]] Gameboard ReferencePosition::makeBoard() const
+{
+    Gameboard board{};
+    for (const auto& action : actions) {
+        assert(action.isValid(board));
+        action.execute(board);
+        board.switchTurn();
+    }
+
+    return board;
+}
+
+[[nodiscard]] const std::array<ReferencePosition, 4>& getReferencePositions()
+{
+    return referencePositions;
+}
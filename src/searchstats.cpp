@@ -0,0 +1,108 @@
+#include "searchstats.h"
+
+#include <ostream>
+
+namespace {
+/**
+ * Give the number of plies with nodes
+ */
+[[nodiscard]] std::size_t getSearchedPlyCount(const SearchStats& stats)
+{
+    std::size_t count = stats.plyNodeCounts.size();
+    while (count > 0 && stats.plyNodeCounts[count - 1] == 0) {
+        --count;
+    }
+    return count;
+}
+
+[[nodiscard]] double getRate(std::uint64_t count, std::uint64_t total)
+{
+    return (total > 0) ? static_cast<double>(count) / static_cast<double>(total) : 0.0;
+}
+} // namespace
+
+void SearchStats::merge(const SearchStats& other)
+{
+    nodeCount += other.nodeCount;
+    quiescenceNodeCount += other.quiescenceNodeCount;
+    evaluationCount += other.evaluationCount;
+    probeCount += other.probeCount;
+    hitCount += other.hitCount;
+    storeCount += other.storeCount;
+
+    for (std::size_t i = 0; i < cutoffCounts.size(); ++i) {
+        cutoffCounts[i] += other.cutoffCounts[i];
+    }
+    for (std::size_t i = 0; i < plyNodeCounts.size(); ++i) {
+        plyNodeCounts[i] += other.plyNodeCounts[i];
+    }
+}
+
+[[nodiscard]] double SearchStats::getBranchingFactor(std::size_t ply) const
+{
+    if (ply + 1 >= plyNodeCounts.size()) {
+        return 0.0;
+    }
+    return getRate(plyNodeCounts[ply + 1], plyNodeCounts[ply]);
+}
+
+[[nodiscard]] double SearchStats::getNodesPerSecond() const
+{
+    return (elapsed.count() > 0) ? static_cast<double>(nodeCount) * 1e6 / static_cast<double>(elapsed.count()) : 0.0;
+}
+
+void SearchStats::print(std::ostream& out) const
+{
+    out << "Search: " << nodeCount << " nodes (" << quiescenceNodeCount << " in quiescence) in " << elapsed.count() / 1000.0
+        << " ms by " << threadCount << " threads, " << getNodesPerSecond() << " nodes/s\n";
+    out << "Evaluations: " << evaluationCount << ", table: " << probeCount << " probes, " << 100.0 * getRate(hitCount, probeCount)
+        << "% hits, " << storeCount << " stores\n";
+
+    std::uint64_t cutoffCount = 0;
+    for (auto count : cutoffCounts) {
+        cutoffCount += count;
+    }
+    out << "Cutoffs: " << cutoffCount << ", by action index:";
+    for (auto count : cutoffCounts) {
+        out << " " << 100.0 * getRate(count, cutoffCount) << "%";
+    }
+
+    out << "\nBranching factors:";
+    const std::size_t searchedPlyCount = getSearchedPlyCount(*this);
+    for (std::size_t ply = 0; ply + 1 < searchedPlyCount; ++ply) {
+        out << " " << getBranchingFactor(ply);
+    }
+    out << "\n";
+
+    for (const auto& iteration : iterations) {
+        out << "Depth " << iteration.depth << ": score = " << iteration.score << ", nodes = " << iteration.nodeCount
+            << ", time = " << iteration.elapsed.count() / 1000.0 << " ms\n";
+    }
+}
+
+void SearchStats::writeJson(std::ostream& out) const
+{
+    out << "{\"threads\":" << threadCount << ",\"elapsedUs\":" << elapsed.count() << ",\"nodes\":" << nodeCount
+        << ",\"quiescenceNodes\":" << quiescenceNodeCount << ",\"nodesPerSecond\":" << getNodesPerSecond()
+        << ",\"evaluations\":" << evaluationCount << ",\"tableProbes\":" << probeCount << ",\"tableHits\":" << hitCount
+        << ",\"tableStores\":" << storeCount;
+
+    out << ",\"cutoffsByActionIndex\":[";
+    for (std::size_t i = 0; i < cutoffCounts.size(); ++i) {
+        out << ((i > 0) ? "," : "") << cutoffCounts[i];
+    }
+
+    out << "],\"branchingFactors\":[";
+    const std::size_t searchedPlyCount = getSearchedPlyCount(*this);
+    for (std::size_t ply = 0; ply + 1 < searchedPlyCount; ++ply) {
+        out << ((ply > 0) ? "," : "") << getBranchingFactor(ply);
+    }
+
+    out << "],\"iterations\":[";
+    for (std::size_t i = 0; i < iterations.size(); ++i) {
+        const auto& iteration = iterations[i];
+        out << ((i > 0) ? "," : "") << "{\"depth\":" << iteration.depth << ",\"score\":" << iteration.score
+            << ",\"nodes\":" << iteration.nodeCount << ",\"elapsedUs\":" << iteration.elapsed.count() << "}";
+    }
+    out << "]}";
+}
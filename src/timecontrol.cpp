@@ -0,0 +1,20 @@
+#include "timecontrol.h"
+
+#include <algorithm>
+
+void TimeControl::completeIteration(bool bestActionChanged)
+{
+    if (m_isLimited && bestActionChanged) {
+        m_softTarget = std::min(m_softTarget + m_hardCap * extensionPercent / 100, m_hardCap);
+    }
+}
+
+bool TimeControl::canStartIteration() const
+{
+    return !m_isLimited || Clock::now() - m_start < m_softTarget;
+}
+
+bool TimeControl::isHardCapReached(std::uint64_t nodeCount) const
+{
+    return m_isLimited && nodeCount % nodesBetweenChecks == 0 && Clock::now() - m_start >= m_hardCap;
+}
@@ -0,0 +1,133 @@
+#include "transpositiontable.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <cassert>
+
+TranspositionTable::TranspositionTable(std::size_t sizeInMB)
+{
+    resize(sizeInMB);
+}
+
+void TranspositionTable::resize(std::size_t sizeInMB)
+{
+    std::size_t maxCount = std::max<std::size_t>(sizeInMB * 1024 * 1024 / sizeof(Bucket), 1);
+
+    std::size_t count = 1;
+    while (count * 2 <= maxCount) {
+        count *= 2;
+    }
+
+    m_buckets = std::vector<Bucket>(count);
+}
+
+void TranspositionTable::clear()
+{
+    for (Bucket& bucket : m_buckets) {
+        for (Entry& entry : bucket.depthPreferred) {
+            entry.reset();
+        }
+        bucket.alwaysReplace.reset();
+    }
+}
+
+[[nodiscard]] std::optional<TranspositionTable::Result> TranspositionTable::probe(std::uint64_t key) const
+{
+    const Bucket& bucket = getBucket(key);
+
+    // The position may be both in a depth-preferred entry and in the always-replaced one,
+    // the result of the current search is chosen first, then the deepest one
+    std::optional<Data> found{};
+    auto probeEntry = [this, &key, &found](const Entry& entry) {
+        // The data is read once, so the key check and the result use the same data
+        Data data = entry.getData();
+        if (!data.isUsed() || (entry.keyXorData.load(std::memory_order_relaxed) ^ data.pack()) != key) {
+            return;
+        }
+
+        if (!found || std::make_pair(data.generation == m_generation, data.depth) >
+                              std::make_pair(found->generation == m_generation, found->depth)) {
+            found = data;
+        }
+    };
+
+    for (const Entry& entry : bucket.depthPreferred) {
+        probeEntry(entry);
+    }
+    probeEntry(bucket.alwaysReplace);
+
+    if (!found) {
+        return std::nullopt;
+    }
+    return makeResult(*found);
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, long score, Bound bound, const Action& bestMove)
+{
+    assert(depth >= 0 && depth <= std::numeric_limits<std::uint8_t>::max());
+
+    // A wrapped score would be wrong, so it is better not to keep it
+    if (score < std::numeric_limits<std::int16_t>::min() || score > std::numeric_limits<std::int16_t>::max()) {
+        return;
+    }
+
+    Data newData{bestMove.pack(),
+                 static_cast<std::int16_t>(score),
+                 static_cast<std::uint8_t>(depth),
+                 bound,
+                 m_generation};
+
+    Bucket& bucket = getBucket(key);
+
+    // The same position is kept in a single depth-preferred entry, updated in place by a deeper
+    // search or by any search after the one which stored it. A shallower result of the same search
+    // goes to the always-replaced entry, and the deeper one is kept for the cutoffs.
+    for (Entry& entry : bucket.depthPreferred) {
+        Data data = entry.getData();
+        if (data.isUsed() && entry.getKey() == key) {
+            if (depth >= data.depth || data.generation != m_generation) {
+                entry.set(key, newData);
+            } else {
+                bucket.alwaysReplace.set(key, newData);
+            }
+            return;
+        }
+    }
+
+    // Otherwise the entries of the previous searches are replaced first, then the shallowest one if the new search is deeper
+    auto isReplaceable = [this](const Data& data) {
+        return !data.isUsed() || data.generation != m_generation;
+    };
+
+    Entry* shallowest = nullptr;
+    Data shallowestData{};
+    for (Entry& entry : bucket.depthPreferred) {
+        Data data = entry.getData();
+        if (shallowest == nullptr ||
+            std::make_pair(!isReplaceable(data), data.depth) < std::make_pair(!isReplaceable(shallowestData), shallowestData.depth)) {
+            shallowest = &entry;
+            shallowestData = data;
+        }
+    }
+
+    if (isReplaceable(shallowestData) || depth >= shallowestData.depth) {
+        shallowest->set(key, newData);
+    } else {
+        bucket.alwaysReplace.set(key, newData);
+    }
+}
+
+void TranspositionTable::newSearch()
+{
+    m_generation = static_cast<std::uint8_t>((m_generation + 1) % generationCount);
+}
+
+[[nodiscard]] TranspositionTable::Result TranspositionTable::makeResult(const Data& data)
+{
+    return Result{data.depth,
+                  data.score,
+                  data.bound,
+                  Action::unpack(data.move)};
+}
@@ -0,0 +1,101 @@
+/**
+ * A tool counting the sequences of actions from stored states (perft)
+ *
+ * The counts are done on a Gameboard and on a Bitboard, which must agree, and are
+ * compared to the counts known to be right up to depth 3. The number of sequences counted
+ * per second is the speed of the generation and the execution of the actions.
+ * The states are the reference positions, so they do not depend on the order in which
+ * the actions are generated.
+ *
+ * Usage: perft [depth]
+ */
+#include "action.h"
+#include "bitboard.h"
+#include "gameboard.h"
+#include "perft.h"
+#include "referencepositions.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <cstdint>
+
+namespace {
+constexpr int checkedDepth = 3; ///< The deepest count stored for each state
+
+/**
+ * The counts known to be right from depth 1, for each of the reference positions
+ */
+constexpr std::array<std::array<std::uint64_t, checkedDepth>, 4> knownCounts{{
+    {80, 6422, 519090},
+    {96, 8530, 789961},
+    {69, 6360, 419332},
+    {49, 2203, 114280},
+}};
+
+/**
+ * Count the sequences of actions and tell how fast it has been done
+ * \return The number of sequences
+ */
+template<typename Board>
+[[nodiscard]] std::uint64_t countAndTime(Board& board, int depth, const char* boardName)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t count = perft(board, depth);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "  " << boardName << ": " << count << " in " << elapsed.count() << " s, "
+              << ((elapsed.count() > 0.0) ? static_cast<double>(count) / elapsed.count() : 0.0) << " sequences/s\n";
+    return count;
+}
+
+void printDivide(Gameboard& gameboard, Bitboard& bitboard, int depth)
+{
+    auto gameboardCounts = perftDivide(gameboard, depth);
+    auto bitboardCounts = perftDivide(bitboard, depth);
+
+    for (std::size_t i = 0; i < std::max(gameboardCounts.size(), bitboardCounts.size()); ++i) {
+        if (i >= gameboardCounts.size() || i >= bitboardCounts.size() || gameboardCounts[i] != bitboardCounts[i]) {
+            const Action& action = (i < gameboardCounts.size()) ? gameboardCounts[i].first : bitboardCounts[i].first;
+            std::cout << "  First difference after the action " << action << "\n";
+            return;
+        }
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int maxDepth = (argc > 1) ? std::atoi(argv[1]) : checkedDepth;
+    bool isRight = true;
+
+    const auto& positions = getReferencePositions();
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        const auto& position = positions[i];
+        Gameboard gameboard = position.makeBoard();
+        Bitboard bitboard{gameboard};
+
+        std::cout << position.name << "\n";
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            std::cout << " Depth " << depth << "\n";
+            const std::uint64_t gameboardCount = countAndTime(gameboard, depth, "Gameboard");
+            const std::uint64_t bitboardCount = countAndTime(bitboard, depth, "Bitboard");
+
+            if (gameboardCount != bitboardCount) {
+                std::cout << "  The boards disagree\n";
+                printDivide(gameboard, bitboard, depth);
+                isRight = false;
+            } else if (depth <= checkedDepth && gameboardCount != knownCounts[i][static_cast<std::size_t>(depth - 1)]) {
+                std::cout << "  Expected " << knownCounts[i][static_cast<std::size_t>(depth - 1)] << "\n";
+                isRight = false;
+            }
+        }
+    }
+
+    std::cout << (isRight ? "All the counts are right\n" : "Some counts are wrong\n");
+    return isRight ? EXIT_SUCCESS : EXIT_FAILURE;
+}
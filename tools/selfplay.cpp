@@ -0,0 +1,336 @@
+/**
+ * A tool playing games between two settings of the AI, without display
+ *
+ * The engines A and B play each game with the other team than in the previous one,
+ * and several games are played at the same time. The result of each game is written
+ * in <output prefix>-games.csv and the time of each action in <output prefix>-moves.csv,
+ * so the changes of the engine can be compared on many games.
+ *
+ * Usage: selfplay <output prefix> [options], or selfplay --help
+ *  --games N          The number of games (100)
+ *  --parallel N       The number of games played at the same time (every core)
+ *  --max-plies N      The number of actions after which a game is a draw (200)
+ *  --time-a MS        The time given to each action of A (100), --time-b for B
+ *  --threads-a N      The number of search threads of A (1), --threads-b for B
+ *  --hash-a MB        The size of the transposition table of A, --hash-b for B
+ *  --ponder-a 0|1     If A searches while B plays (0), --ponder-b for B
+ *  --weights-a FILE   The weights of the evaluation of A, --weights-b for B
+ *  --stats 0|1        Write the statistics of the search of each action in <output prefix>-stats.jsonl,
+ *                     one JSON object per line (0), only if the AI is built with SEARCH_STATS
+ */
+#include "gameai.h"
+#include "gameboard.h"
+#include "logger.h"
+#include "utility.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * The time of an action of a game
+ */
+struct MoveRecord {
+    std::size_t engine; ///< 0 for A, 1 for B
+    PlayerTeam team;
+    double milliseconds;
+    SearchStats stats; ///< Empty unless the AI is built with SEARCH_STATS
+};
+
+/**
+ * How a game has ended
+ */
+struct GameRecord {
+    std::size_t cthulhuEngine{0}; ///< The engine playing Cthulhu, the other one plays Satan
+    int winner{-1}; ///< The engine which has won, -1 for a draw
+    std::vector<MoveRecord> moves{};
+};
+
+constexpr std::array<const char*, 2> engineNames{"A", "B"};
+
+[[nodiscard]] const char* getTeamName(PlayerTeam team)
+{
+    return (team == PlayerTeam::Cthulhu) ? "Cthulhu" : "Satan";
+}
+
+void playGame(GameRecord& record, const std::array<SearchSettings, 2>& settings, int maxPlies)
+{
+    const std::size_t satanEngine = 1 - record.cthulhuEngine;
+
+    std::array<GameAI, 2> players{GameAI{PlayerTeam::Cthulhu, settings[record.cthulhuEngine]},
+                                  GameAI{PlayerTeam::Satan, settings[satanEngine]}};
+    Gameboard board{};
+
+    for (int ply = 0; ply < maxPlies && !board.hasWon(PlayerTeam::Cthulhu) && !board.hasWon(PlayerTeam::Satan); ++ply) {
+        const PlayerTeam team = board.getPlayingTeam();
+        GameAI& player = players[teamIndex(team)];
+        GameAI& enemy = players[(team == PlayerTeam::Cthulhu) ? 1 : 0];
+
+        const auto start = std::chrono::steady_clock::now();
+        player.waitToPlay(board);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        record.moves.push_back(MoveRecord{(team == PlayerTeam::Cthulhu) ? record.cthulhuEngine : satanEngine, team, elapsed.count(),
+                                          player.getLastSearchStats()});
+        enemy.askToPlay(board);
+    }
+
+    if (board.hasWon(PlayerTeam::Cthulhu)) {
+        record.winner = static_cast<int>(record.cthulhuEngine);
+    } else if (board.hasWon(PlayerTeam::Satan)) {
+        record.winner = static_cast<int>(satanEngine);
+    }
+}
+
+[[nodiscard]] bool writeStats(const std::string& outputPrefix, const std::vector<GameRecord>& records)
+{
+    std::ofstream stats{outputPrefix + "-stats.jsonl"};
+    if (!stats) {
+        return false;
+    }
+
+    for (std::size_t game = 0; game < records.size(); ++game) {
+        const auto& moves = records[game].moves;
+        for (std::size_t ply = 0; ply < moves.size(); ++ply) {
+            stats << "{\"game\":" << game << ",\"ply\":" << ply << ",\"engine\":\"" << engineNames[moves[ply].engine]
+                  << "\",\"search\":";
+            moves[ply].stats.writeJson(stats);
+            stats << "}\n";
+        }
+    }
+
+    return static_cast<bool>(stats);
+}
+
+[[nodiscard]] bool writeRecords(const std::string& outputPrefix, const std::vector<GameRecord>& records)
+{
+    std::ofstream games{outputPrefix + "-games.csv"};
+    std::ofstream moves{outputPrefix + "-moves.csv"};
+    if (!games || !moves) {
+        return false;
+    }
+
+    games << "game,cthulhu,satan,winner,plies\n";
+    moves << "game,ply,engine,team,ms\n";
+    for (std::size_t game = 0; game < records.size(); ++game) {
+        const auto& record = records[game];
+        games << game << "," << engineNames[record.cthulhuEngine] << "," << engineNames[1 - record.cthulhuEngine] << ","
+              << ((record.winner >= 0) ? engineNames[static_cast<std::size_t>(record.winner)] : "draw") << ","
+              << record.moves.size() << "\n";
+
+        for (std::size_t ply = 0; ply < record.moves.size(); ++ply) {
+            const auto& move = record.moves[ply];
+            moves << game << "," << ply << "," << engineNames[move.engine] << "," << getTeamName(move.team) << ","
+                  << move.milliseconds << "\n";
+        }
+    }
+
+    return static_cast<bool>(games) && static_cast<bool>(moves);
+}
+
+void printUsage(std::ostream& out, const char* program)
+{
+    out << "Usage: " << program << " <output prefix> [options]\n"
+        << "  --games N          The number of games (100)\n"
+        << "  --parallel N       The number of games played at the same time (every core)\n"
+        << "  --max-plies N      The number of actions after which a game is a draw (200)\n"
+        << "  --time-a MS        The time given to each action of A (100), --time-b for B\n"
+        << "  --threads-a N      The number of search threads of A (1, 0 for every core), --threads-b for B\n"
+        << "  --hash-a MB        The size of the transposition table of A, --hash-b for B\n"
+        << "  --ponder-a 0|1     If A searches while B plays (0), --ponder-b for B\n"
+        << "  --weights-a FILE   The weights of the evaluation of A, --weights-b for B\n"
+        << "  --stats 0|1        Write the statistics of the search of each action in <output prefix>-stats.jsonl (0)\n";
+}
+
+/**
+ * Read the number given to an option
+ *
+ * \param value The value of the option
+ * \param min The smallest number allowed
+ * \param number The number read
+ * \return False if the value is not a whole number, or is too small or too big
+ */
+[[nodiscard]] bool parseNumber(const std::string& value, long min, long& number)
+{
+    char* end = nullptr;
+    errno = 0;
+    number = std::strtol(value.c_str(), &end, 10);
+    return !value.empty() && *end == '\0' && errno == 0 && number >= min;
+}
+
+/**
+ * Read the 0 or 1 given to an option
+ *
+ * \param value The value of the option
+ * \param flag The flag read
+ * \return False if the value is neither 0 nor 1
+ */
+[[nodiscard]] bool parseFlag(const std::string& value, bool& flag)
+{
+    flag = (value == "1");
+    return value == "0" || value == "1";
+}
+
+void printSummary(const std::vector<GameRecord>& records)
+{
+    std::array<int, 2> wins{};
+    int draws = 0;
+    std::array<double, 2> totalTime{};
+    std::array<double, 2> maxTime{};
+    std::array<std::size_t, 2> moveCount{};
+
+    for (const auto& record : records) {
+        if (record.winner >= 0) {
+            ++wins[static_cast<std::size_t>(record.winner)];
+        } else {
+            ++draws;
+        }
+
+        for (const auto& move : record.moves) {
+            totalTime[move.engine] += move.milliseconds;
+            maxTime[move.engine] = std::max(maxTime[move.engine], move.milliseconds);
+            ++moveCount[move.engine];
+        }
+    }
+
+    std::cout << "Games: " << records.size() << ", A wins: " << wins[0] << ", B wins: " << wins[1] << ", draws: " << draws << "\n";
+    for (std::size_t engine = 0; engine < 2; ++engine) {
+        std::cout << engineNames[engine] << ": " << moveCount[engine] << " actions, "
+                  << ((moveCount[engine] > 0) ? totalTime[engine] / static_cast<double>(moveCount[engine]) : 0.0)
+                  << " ms per action, " << maxTime[engine] << " ms at most\n";
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        printUsage(std::cerr, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string outputPrefix{argv[1]};
+    if (outputPrefix == "-h" || outputPrefix == "--help") {
+        printUsage(std::cout, argv[0]);
+        return EXIT_SUCCESS;
+    }
+    if (outputPrefix.compare(0, 2, "--") == 0) {
+        std::cerr << "The output prefix must come before the options\n";
+        printUsage(std::cerr, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::size_t gameCount = 100;
+    unsigned parallelGames = std::max(1U, std::thread::hardware_concurrency());
+    int maxPlies = 200;
+    bool writesStats = false;
+
+    std::array<SearchSettings, 2> settings{};
+    for (auto& engineSettings : settings) {
+        engineSettings.timeBudget = std::chrono::milliseconds{100};
+        engineSettings.threadCount = 1;
+        engineSettings.ponder = false;
+    }
+
+    for (int i = 2; i < argc; i += 2) {
+        const std::string option{argv[i]};
+        if (option == "-h" || option == "--help") {
+            printUsage(std::cout, argv[0]);
+            return EXIT_SUCCESS;
+        }
+        if (i + 1 == argc) {
+            std::cerr << "The option " << option << " has no value\n";
+            return EXIT_FAILURE;
+        }
+
+        const std::string value{argv[i + 1]};
+        const std::size_t engine = (option.size() > 2 && option.compare(option.size() - 2, 2, "-b") == 0) ? 1 : 0;
+        const std::string name = (option.size() > 2 && option[option.size() - 2] == '-') ? option.substr(0, option.size() - 2) : option;
+
+        long number = 0;
+        bool isValid = true;
+        if (option == "--games") {
+            isValid = parseNumber(value, 1, number);
+            gameCount = static_cast<std::size_t>(number);
+        } else if (option == "--parallel") {
+            isValid = parseNumber(value, 1, number);
+            parallelGames = static_cast<unsigned>(number);
+        } else if (option == "--max-plies") {
+            isValid = parseNumber(value, 1, number);
+            maxPlies = static_cast<int>(number);
+        } else if (option == "--stats") {
+            isValid = parseFlag(value, writesStats);
+        } else if (name == "--time") {
+            isValid = parseNumber(value, 1, number);
+            settings[engine].timeBudget = std::chrono::milliseconds{number};
+        } else if (name == "--threads") {
+            isValid = parseNumber(value, 0, number);
+            settings[engine].threadCount = static_cast<unsigned>(number);
+        } else if (name == "--hash") {
+            isValid = parseNumber(value, 1, number);
+            settings[engine].transpositionTableSize = static_cast<std::size_t>(number);
+        } else if (name == "--ponder") {
+            isValid = parseFlag(value, settings[engine].ponder);
+        } else if (name == "--weights") {
+            if (!settings[engine].evalParams.loadFromFile(value)) {
+                std::cerr << "Can not read the weights from " << value << "\n";
+                return EXIT_FAILURE;
+            }
+        } else {
+            std::cerr << "Unknown option " << option << "\n";
+            printUsage(std::cerr, argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        if (!isValid) {
+            std::cerr << "Wrong value " << value << " for the option " << option << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<GameRecord> records(gameCount);
+    for (std::size_t game = 0; game < gameCount; ++game) {
+        records[game].cthulhuEngine = game % 2;
+    }
+
+    // What the AI tells would be mixed between the games
+    Logger::setLevel(LogLevel::Warning);
+
+    std::atomic<std::size_t> nextGame{0};
+    std::vector<std::thread> runners{};
+    for (unsigned t = 0; t < parallelGames; ++t) {
+        runners.emplace_back([&records, &settings, &nextGame, maxPlies] {
+            for (std::size_t game = nextGame++; game < records.size(); game = nextGame++) {
+                playGame(records[game], settings, maxPlies);
+            }
+        });
+    }
+    for (auto& runner : runners) {
+        runner.join();
+    }
+
+    if (!writeRecords(outputPrefix, records)) {
+        std::cerr << "Can not write the results to " << outputPrefix << "-*.csv\n";
+        return EXIT_FAILURE;
+    }
+    if (writesStats) {
+        if (!SearchStats::enabled) {
+            std::cerr << "The statistics of the search are not counted, the AI must be built with SEARCH_STATS\n";
+        } else if (!writeStats(outputPrefix, records)) {
+            std::cerr << "Can not write the statistics to " << outputPrefix << "-stats.jsonl\n";
+            return EXIT_FAILURE;
+        }
+    }
+    printSummary(records);
+
+    return EXIT_SUCCESS;
+}
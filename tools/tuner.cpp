@@ -0,0 +1,243 @@
+/**
+ * A tool fitting the weights of the evaluation to the results of self-play games
+ *
+ * The games are played by a greedy player, which does the action with the best
+ * evaluation and sometimes a random one so the games differ. Each state of the games
+ * is labelled with the result of its game. Then the weights are fitted Texel-style:
+ * each weight is moved up and down as long as it lowers the mean squared error between
+ * the results and the scores turned into a probability of winning.
+ *
+ * The games are played and the errors computed on all the cores.
+ *
+ * Usage: tuner <output file> [game count] [starting weights file]
+ */
+#include "action.h"
+#include "bitboard.h"
+#include "evaluation.h"
+#include "movelist.h"
+#include "utility.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr int maxPlies = 200; ///< The games longer than that are draws
+constexpr int skippedPlies = 4; ///< The first states are too alike to be worth it
+constexpr double randomActionRate = 0.1;
+
+/**
+ * A state of a self-play game, seen by one of the teams
+ */
+struct Sample {
+    Bitboard board;
+    PlayerTeam team;
+    double result; ///< 1 if the team has won, 0 if it has lost, 0.5 for a draw
+};
+
+[[nodiscard]] bool isOver(const Bitboard& board)
+{
+    return board.hasWon(PlayerTeam::Cthulhu) || board.hasWon(PlayerTeam::Satan);
+}
+
+[[nodiscard]] Action chooseAction(Bitboard& board, const EvalParams& params, std::mt19937& random)
+{
+    MoveList actions{};
+    board.getPossibleActions(actions);
+
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+    if (chance(random) < randomActionRate) {
+        return actions[std::uniform_int_distribution<std::size_t>{0, actions.size() - 1}(random)];
+    }
+
+    const PlayerTeam team = board.getPlayingTeam();
+    Action bestAction = actions.front();
+    long bestScore = 0;
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        auto record = actions[i].executeReversibly(board);
+        long score = board.hasWon(team) ? std::numeric_limits<long>::max() : evaluate(board, team, params);
+        actions[i].undo(board, record);
+
+        if (i == 0 || score > bestScore) {
+            bestScore = score;
+            bestAction = actions[i];
+        }
+    }
+
+    return bestAction;
+}
+
+void playGames(std::size_t gameCount, unsigned seed, const EvalParams& params, std::vector<Sample>& samples)
+{
+    std::mt19937 random{seed};
+
+    for (std::size_t game = 0; game < gameCount; ++game) {
+        Bitboard board{};
+        std::vector<Bitboard> states{};
+
+        for (int ply = 0; ply < maxPlies && !isOver(board); ++ply) {
+            if (ply >= skippedPlies && board.getTeamMask(PlayerTeam::Cthulhu).count() > 1 &&
+                board.getTeamMask(PlayerTeam::Satan).count() > 1) {
+                states.push_back(board);
+            }
+
+            chooseAction(board, params, random).execute(board);
+            board.switchTurn();
+        }
+
+        double cthulhuResult = 0.5;
+        if (board.hasWon(PlayerTeam::Cthulhu)) {
+            cthulhuResult = 1.0;
+        } else if (board.hasWon(PlayerTeam::Satan)) {
+            cthulhuResult = 0.0;
+        }
+
+        for (const auto& state : states) {
+            samples.push_back(Sample{state, PlayerTeam::Cthulhu, cthulhuResult});
+            samples.push_back(Sample{state, PlayerTeam::Satan, 1.0 - cthulhuResult});
+        }
+    }
+}
+
+[[nodiscard]] double winProbability(long score, double scale)
+{
+    return 1.0 / (1.0 + std::exp(-scale * static_cast<double>(score)));
+}
+
+[[nodiscard]] double computeError(const std::vector<Sample>& samples, const EvalParams& params, double scale, unsigned threadCount)
+{
+    std::vector<double> errors(threadCount, 0.0);
+    std::vector<std::thread> threads{};
+
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&samples, &params, &errors, scale, threadCount, t] {
+            for (std::size_t i = t; i < samples.size(); i += threadCount) {
+                double difference = samples[i].result - winProbability(evaluate(samples[i].board, samples[i].team, params), scale);
+                errors[t] += difference * difference;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double error = 0.0;
+    for (double threadError : errors) {
+        error += threadError;
+    }
+    return error / static_cast<double>(samples.size());
+}
+
+/**
+ * Find how the scores are turned into probabilities, so the starting weights fit the best
+ */
+[[nodiscard]] double findScale(const std::vector<Sample>& samples, const EvalParams& params, unsigned threadCount)
+{
+    double bestScale = 1.0;
+    double bestError = 1.0;
+    for (double scale = 1e-5; scale < 1.0; scale *= 1.25) {
+        double error = computeError(samples, params, scale, threadCount);
+        if (error < bestError) {
+            bestError = error;
+            bestScale = scale;
+        }
+    }
+    return bestScale;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <output file> [game count] [starting weights file]\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string outputPath{argv[1]};
+    const std::size_t gameCount = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    EvalParams params{};
+    if (argc > 3 && !params.loadFromFile(argv[3])) {
+        std::cerr << "Can not read the weights from " << argv[3] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const unsigned threadCount = std::max(1U, std::thread::hardware_concurrency());
+
+    // 1. Play the games
+    std::vector<std::vector<Sample>> threadSamples(threadCount);
+    std::vector<std::thread> players{};
+    for (unsigned t = 0; t < threadCount; ++t) {
+        std::size_t threadGameCount = gameCount / threadCount + ((t < gameCount % threadCount) ? 1 : 0);
+        players.emplace_back(playGames, threadGameCount, t + 1, std::cref(params), std::ref(threadSamples[t]));
+    }
+    for (auto& player : players) {
+        player.join();
+    }
+
+    std::vector<Sample> samples{};
+    for (auto& threadSample : threadSamples) {
+        samples.insert(samples.end(), threadSample.begin(), threadSample.end());
+    }
+    if (samples.empty()) {
+        std::cerr << "No state to fit the weights to\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Games: " << gameCount << ", samples: " << samples.size() << ", threads: " << threadCount << "\n";
+
+    // 2. Fit the weights
+    const double scale = findScale(samples, params, threadCount);
+    double bestError = computeError(samples, params, scale, threadCount);
+    std::cout << "Scale: " << scale << ", error: " << bestError << "\n";
+
+    constexpr auto fields = EvalParams::getFields();
+    std::array<int, fields.size()> steps{};
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        steps[i] = std::max(1, std::abs(params.*(fields[i].second)) / 8);
+    }
+
+    bool improved = true;
+    while (improved || std::any_of(steps.begin(), steps.end(), [](int step) { return step > 1; })) {
+        if (!improved) {
+            for (auto& step : steps) {
+                step = std::max(1, step / 2);
+            }
+        }
+        improved = false;
+
+        for (std::size_t i = 0; i < fields.size(); ++i) {
+            int& weight = params.*(fields[i].second);
+            for (int direction : {1, -1}) {
+                weight += direction * steps[i];
+                double error = computeError(samples, params, scale, threadCount);
+                if (error < bestError) {
+                    bestError = error;
+                    improved = true;
+                    break;
+                }
+                weight -= direction * steps[i];
+            }
+        }
+
+        std::cout << "Error: " << bestError << "\n";
+    }
+
+    // 3. Save them
+    for (const auto& [name, member] : fields) {
+        std::cout << name << " = " << params.*member << "\n";
+    }
+
+    if (!params.saveToFile(outputPath)) {
+        std::cerr << "Can not write the weights to " << outputPath << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}